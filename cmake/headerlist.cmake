@@ -10,7 +10,16 @@ set(headers ${headers}
 	include/Service.h
     include/Interaction.h
     include/BoundingBox.hpp
+    include/MPSCQueue.h
+    include/FrameArena.h
+    include/ClientSet.h
+    include/IndexedHeap.h
+    include/TimerWheel.h
+    include/PressGesture.h
+    include/PromptText.h
+    include/Profiler.h
     include/Theme.h
+    include/Trace.h
 	src/ImGui/Graphics.h
     src/ImGui/Styles.h
     src/ImGui/IconsFonts.h
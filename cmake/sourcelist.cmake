@@ -6,10 +6,12 @@ set(sources ${sources}
 	src/MCP.cpp
  	src/Input.cpp
  	src/Renderer.cpp
+ 	src/Platform.cpp
  	src/Service.cpp
  	src/Interaction.cpp
  	src/Tutorial.cpp
  	src/Theme.cpp
+ 	src/Trace.cpp
 	src/ImGui/Graphics.cpp
     src/ImGui/Styles.cpp
     src/ImGui/IconsFonts.cpp
@@ -0,0 +1,149 @@
+#include "Bench.h"
+#include <ctime>
+
+namespace {
+    struct Entry {
+        std::string_view description;
+        Bench::Scenario scenario;
+    };
+
+    std::map<std::string_view, Entry>& Scenarios() {
+        static std::map<std::string_view, Entry> scenarios;
+        return scenarios;
+    }
+
+    template <class T>
+    T Percentile(std::vector<T> a_values, const double a_p) {
+        if (a_values.empty()) {
+            return T{};
+        }
+        const auto n = static_cast<size_t>(a_p * static_cast<double>(a_values.size() - 1));
+        std::ranges::nth_element(a_values, a_values.begin() + n);
+        return a_values[n];
+    }
+
+    template <class T>
+    double Mean(const std::vector<T>& a_values) {
+        if (a_values.empty()) {
+            return 0.0;
+        }
+        return static_cast<double>(std::accumulate(a_values.begin(), a_values.end(), uint64_t{0})) /
+               static_cast<double>(a_values.size());
+    }
+
+    void Usage() {
+        std::fputs("usage: SkyPromptBench <scenario> [--prompts N] [--clients N] [--frames N] [--producers N] "
+                   "[--slots N] [--moves N]\n\nscenarios:\n", stderr);
+        for (const auto& [name, entry] : Scenarios()) {
+            std::fprintf(stderr, "  %-16.*s %.*s\n", static_cast<int>(name.size()), name.data(),
+                         static_cast<int>(entry.description.size()), entry.description.data());
+        }
+    }
+}
+
+uint64_t Bench::ThreadCpuNs() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+void Bench::FrameStats::Begin() {
+    start_counters_ = Counters::Now();
+    start_ns_ = ThreadCpuNs();
+}
+
+void Bench::FrameStats::End() {
+    const auto end_ns = ThreadCpuNs();
+    const auto counters = Counters::Now() - start_counters_;
+    cpu_ns_.push_back(end_ns - start_ns_);
+    locks_.push_back(counters.locks);
+    allocations_.push_back(counters.allocations);
+}
+
+double Bench::FrameStats::MeanAllocations() const {
+    return Mean(allocations_);
+}
+
+double Bench::FrameStats::MeanLocks() const {
+    return Mean(locks_);
+}
+
+void Bench::FrameStats::Print(const std::string_view a_label) const {
+    std::printf("%-28.*s frames %6zu | cpu us mean %8.2f p50 %8.2f p99 %8.2f | locks mean %6.2f max %4llu | "
+                "allocs mean %7.2f max %5llu\n",
+                static_cast<int>(a_label.size()), a_label.data(), cpu_ns_.size(), Mean(cpu_ns_) / 1000.0,
+                static_cast<double>(Percentile(cpu_ns_, 0.5)) / 1000.0,
+                static_cast<double>(Percentile(cpu_ns_, 0.99)) / 1000.0, Mean(locks_),
+                static_cast<unsigned long long>(Percentile(locks_, 1.0)), Mean(allocations_),
+                static_cast<unsigned long long>(Percentile(allocations_, 1.0)));
+}
+
+Bench::Population::Population(const Options& a_options, const int a_count) {
+    for (int i = 0; i < std::max(a_options.clients, 1); ++i) {
+        clients.push_back(SkyPromptAPI::RequestClientID());
+    }
+    for (int i = 0; i < a_count; ++i) {
+        const auto client = static_cast<size_t>(i) % clients.size();
+        const auto per_client = static_cast<size_t>(i) / clients.size();
+        TestSink::Spec spec{.text = std::format("Prompt {}", i),
+                            .event = static_cast<SkyPromptAPI::EventID>(per_client % a_options.slots + 1),
+                            .action = static_cast<SkyPromptAPI::ActionID>(per_client + 1)};
+        sinks.push_back(std::make_unique<TestSink>(std::vector{std::move(spec)}));
+        owners.push_back(clients[client]);
+    }
+}
+
+void Bench::Population::SendAll() const {
+    for (size_t i = 0; i < sinks.size(); ++i) {
+        (void)SkyPromptAPI::SendPrompt(sinks[i].get(), owners[i]);
+    }
+}
+
+bool Bench::Register(const std::string_view a_name, const std::string_view a_description, const Scenario a_scenario) {
+    Scenarios().emplace(a_name, Entry{a_description, a_scenario});
+    return true;
+}
+
+int main(const int argc, char** argv) {
+    if (argc < 2) {
+        Usage();
+        return 2;
+    }
+    const auto it = Scenarios().find(argv[1]);
+    if (it == Scenarios().end()) {
+        Usage();
+        return 2;
+    }
+    Bench::Options options;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        const std::string_view flag = argv[i];
+        const int value = std::atoi(argv[i + 1]);
+        if (flag == "--prompts") {
+            options.prompts = value;
+        } else if (flag == "--clients") {
+            options.clients = value;
+        } else if (flag == "--frames") {
+            options.frames = value;
+        } else if (flag == "--producers") {
+            options.producers = value;
+        } else if (flag == "--slots") {
+            options.slots = value;
+        } else if (flag == "--moves") {
+            options.moves = value;
+        } else {
+            Usage();
+            return 2;
+        }
+    }
+    options.clients = std::max(options.clients, 1);
+    options.slots = std::max(options.slots, 1);
+
+    spdlog::set_level(spdlog::level::warn);
+    Headless::Init(options.slots);
+    // prompts stay up for the whole run unless a scenario says otherwise
+    MCP::Settings::lifetime = 1e6f;
+    std::printf("%s: prompts %d, clients %d, frames %d\n", argv[1], options.prompts, options.clients,
+                options.frames);
+    it->second.scenario(options);
+    return 0;
+}
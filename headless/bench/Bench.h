@@ -0,0 +1,56 @@
+#pragma once
+#include "Counters.h"
+#include "Headless.h"
+#include "TestSink.h"
+
+// Scenarios register themselves with BENCH_SCENARIO and are picked by name on the command line:
+//   SkyPromptBench <scenario> [--prompts N] [--clients N] [--frames N] [--producers N] [--slots N] [--moves N]
+namespace Bench {
+    struct Options {
+        int prompts = 16;
+        int clients = 1;
+        int frames = 1000;
+        int producers = 4;
+        int slots = 8;
+        // input events per frame, for the input scenarios
+        int moves = 8;
+    };
+
+    // per-frame CPU time of the calling thread, plus the locks it took and the allocations it made
+    class FrameStats {
+    public:
+        void Begin();
+        void End();
+        void Print(std::string_view a_label) const;
+        [[nodiscard]] size_t Frames() const { return cpu_ns_.size(); }
+        [[nodiscard]] double MeanAllocations() const;
+        [[nodiscard]] double MeanLocks() const;
+
+    private:
+        std::vector<uint64_t> cpu_ns_;
+        std::vector<uint64_t> locks_;
+        std::vector<uint64_t> allocations_;
+        uint64_t start_ns_ = 0;
+        Counters::Snapshot start_counters_;
+    };
+
+    [[nodiscard]] uint64_t ThreadCpuNs();
+
+    // a_count sinks with one prompt each, spread over a_clients clients and the slots of each
+    struct Population {
+        std::vector<SkyPromptAPI::ClientID> clients;
+        std::vector<std::unique_ptr<TestSink>> sinks;
+        std::vector<SkyPromptAPI::ClientID> owners;
+
+        Population(const Options& a_options, int a_count);
+        void SendAll() const;
+    };
+
+    using Scenario = void (*)(const Options&);
+    bool Register(std::string_view a_name, std::string_view a_description, Scenario a_scenario);
+}
+
+#define BENCH_SCENARIO(name, description)                                                   \
+    static void BenchScenario_##name(const Bench::Options&);                                \
+    static const bool bench_registered_##name = Bench::Register(#name, description, BenchScenario_##name); \
+    static void BenchScenario_##name(const Bench::Options& a_options)
@@ -0,0 +1,133 @@
+#include "Bench.h"
+
+// Closing the gap an emptied slot leaves, the way CleanUpQueue does it now (erase the SubManager, renumber the ones
+// after it) and the way ReArrange did it before: copy every button and sink out, drop all SubManagers and the owner
+// index, and add everything back. The rebuild is replayed with today's InteractionButton, so the difference is the
+// algorithm alone; what the old record cost on top is in the `queue` scenario.
+
+namespace {
+    using ImGui::Renderer::SubManager;
+
+    constexpr int prompts_per_slot = 3;
+
+    struct Slots {
+        double clock = 0.0;
+        std::vector<std::unique_ptr<SubManager>> managers;
+        // what each slot was given, standing in for SubManager::GetButtons, which ReArrange copied from
+        std::vector<std::vector<InteractionButton>> buttons;
+        std::vector<std::unique_ptr<TestSink>> sinks;
+        std::vector<std::shared_ptr<const ImGui::Renderer::SubmittedPrompts>> submitted;
+        // Manager::interaction_index_ and event_index_
+        std::unordered_map<uint64_t, SubManager*> interaction_index;
+        std::unordered_map<SCENES::Event, SubManager*> event_index;
+
+        void Add(SubManager& a_manager, const InteractionButton& a_button, const size_t a_sink) {
+            const auto a_ref = a_button.attached_object.get().get();
+            a_manager.Add2Q(InteractionButton(a_button.interaction, a_button.mutables, a_button.type,
+                                              a_ref ? a_ref->GetFormID() : 0, a_button.keys,
+                                              a_button.default_key_index));
+            a_manager.AddSink(a_button.interaction, sinks[a_sink].get(), submitted[a_sink]->prompts, 0);
+            interaction_index[a_button.interaction.Key()] = &a_manager;
+            event_index[a_button.interaction.event] = &a_manager;
+        }
+
+        explicit Slots(const int a_slots) {
+            for (int s = 0; s < a_slots; ++s) {
+                auto& a_manager = *managers.emplace_back(std::make_unique<SubManager>(clock));
+                auto& slot_buttons = buttons.emplace_back();
+                for (int p = 0; p < prompts_per_slot; ++p) {
+                    const auto event = static_cast<SkyPromptAPI::EventID>(s + 1);
+                    const auto action = static_cast<SkyPromptAPI::ActionID>(p + 1);
+                    const auto refid = static_cast<RefID>(0x1000 + s * prompts_per_slot + p);
+                    (void)Headless::AddReference(refid);
+                    sinks.push_back(std::make_unique<TestSink>(std::vector<TestSink::Spec>{
+                        {.text = std::format("Prompt {} {}", s, p), .event = event, .action = action,
+                         .refid = refid}}));
+                    submitted.push_back(std::make_shared<const ImGui::Renderer::SubmittedPrompts>(
+                        sinks.back()->GetPrompts()));
+                    const auto& prompt = submitted.back()->prompts.front();
+                    slot_buttons.emplace_back(Interaction(event, action),
+                                              ImGui::Renderer::ButtonMutables{prompt.text_color, prompt.progress,
+                                                                              PromptText::Ref(prompt.text)},
+                                              prompt.type, refid, InteractionButton::Keys{}, s);
+                    Add(a_manager, slot_buttons.back(), sinks.size() - 1);
+                }
+            }
+        }
+
+        // the prompts of a_slot time out: its SubManager stays, empty, until the clean-up
+        void Empty(const size_t a_slot) {
+            for (int p = 0; p < prompts_per_slot; ++p) {
+                managers[a_slot]->RemoveFromQ(sinks[a_slot * prompts_per_slot + p].get());
+            }
+            buttons[a_slot].clear();
+        }
+
+        std::vector<const SkyPromptAPI::PromptSink*> Compact() {
+            std::vector<const SkyPromptAPI::PromptSink*> departed;
+            size_t first_removed = managers.size();
+            for (size_t i = managers.size(); i-- > 0;) {
+                if (managers[i]->HasQueue()) {
+                    continue;
+                }
+                for (const auto a_sink : managers[i]->GetSinks()) {
+                    departed.push_back(a_sink);
+                }
+                const auto owned_by = [a_manager = managers[i].get()](const auto& a_entry) {
+                    return a_entry.second == a_manager;
+                };
+                std::erase_if(interaction_index, owned_by);
+                std::erase_if(event_index, owned_by);
+                managers.erase(managers.begin() + static_cast<std::ptrdiff_t>(i));
+                first_removed = i;
+            }
+            for (size_t i = first_removed; i < managers.size(); ++i) {
+                managers[i]->SetSlot(static_cast<int>(i));
+            }
+            return departed;
+        }
+
+        void Rebuild() {
+            // copy out what is left, by event, with the sinks that go with each button
+            std::map<SCENES::Event, std::vector<std::pair<InteractionButton, size_t>>> interactions;
+            for (size_t s = 0; s < buttons.size(); ++s) {
+                for (size_t p = 0; p < buttons[s].size(); ++p) {
+                    interactions[buttons[s][p].interaction.event].emplace_back(buttons[s][p],
+                                                                               s * prompts_per_slot + p);
+                }
+            }
+            managers.clear();
+            interaction_index.clear();
+            event_index.clear();
+            for (auto& a_buttons : interactions | std::views::values) {
+                auto& a_manager = *managers.emplace_back(std::make_unique<SubManager>(clock));
+                for (auto& [a_button, a_sink] : a_buttons) {
+                    a_button.default_key_index = static_cast<int>(managers.size() - 1);
+                    Add(a_manager, a_button, a_sink);
+                }
+            }
+        }
+    };
+}
+
+BENCH_SCENARIO(compact, "--frames clean-ups of 4, 8 and 16 slots after the first empties, compact and old rebuild") {
+    for (const int slots : {4, 8, 16}) {
+        for (const bool rebuild : {true, false}) {
+            // the first slot empties, so every other one has to move up
+            Bench::FrameStats stats;
+            for (int i = 0; i < a_options.frames; ++i) {
+                Slots state(slots);
+                state.Empty(0);
+                PromptText::GetStore().Collect();
+                stats.Begin();
+                if (rebuild) {
+                    state.Rebuild();
+                } else {
+                    (void)state.Compact();
+                }
+                stats.End();
+            }
+            stats.Print(std::format("{:2} slots, {}", slots, rebuild ? "rebuild (before)" : "compact"));
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#include "Bench.h"
+
+// The queue as the render thread sees it: a frame with nothing changing, and frames where prompts come and go.
+
+BENCH_SCENARIO(frame, "steady frames with --prompts prompts shown") {
+    const Bench::Population population(a_options, a_options.prompts);
+    population.SendAll();
+    for (int i = 0; i < 10; ++i) {
+        Headless::Tick();
+    }
+    Bench::FrameStats stats;
+    for (int i = 0; i < a_options.frames; ++i) {
+        stats.Begin();
+        Headless::Tick();
+        stats.End();
+    }
+    stats.Print("steady frame");
+}
+
+BENCH_SCENARIO(churn, "every frame one prompt is removed and another sent (Add2Q/RemoveFromQ)") {
+    // half the sinks are up at any time, the other half wait to be swapped in
+    const Bench::Population population(a_options, std::max(a_options.prompts, 1) * 2);
+    const auto half = population.sinks.size() / 2;
+    for (size_t i = 0; i < half; ++i) {
+        (void)SkyPromptAPI::SendPrompt(population.sinks[i].get(), population.owners[i]);
+    }
+    for (int i = 0; i < 10; ++i) {
+        Headless::Tick();
+    }
+    Bench::FrameStats api;
+    Bench::FrameStats frame;
+    for (int i = 0; i < a_options.frames; ++i) {
+        const auto out = static_cast<size_t>(i) % population.sinks.size();
+        const auto in = (out + half) % population.sinks.size();
+        api.Begin();
+        SkyPromptAPI::RemovePrompt(population.sinks[out].get(), population.owners[out]);
+        (void)SkyPromptAPI::SendPrompt(population.sinks[in].get(), population.owners[in]);
+        api.End();
+        frame.Begin();
+        Headless::Tick();
+        frame.End();
+    }
+    api.Print("remove + send (caller)");
+    frame.Print("frame applying them");
+}
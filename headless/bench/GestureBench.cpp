@@ -0,0 +1,30 @@
+#include "Bench.h"
+#include <random>
+
+// The press-count state machine on its own, fed a recorded-looking stream of events with no queue around it.
+
+BENCH_SCENARIO(gesture, "--frames x 10000 PressGesture transitions over a random event stream") {
+    using namespace PressGesture;
+    std::mt19937 rng(5);
+    // mostly edges and frame checks, like a real burst of presses
+    std::discrete_distribution<int> event({25, 25, 3, 20, 25, 2});
+    std::vector<Event> events(65'536);
+    for (auto& a_event : events) {
+        a_event = static_cast<Event>(event(rng));
+    }
+
+    const auto transitions = static_cast<uint64_t>(std::max(a_options.frames, 1)) * 10'000;
+    for (const bool has_progress : {false, true}) {
+        Machine machine;
+        uint64_t actions = 0;
+        const auto start_ns = Bench::ThreadCpuNs();
+        for (uint64_t i = 0; i < transitions; ++i) {
+            actions += machine.Feed(events[i & (events.size() - 1)], has_progress) != Action::kNone;
+        }
+        const auto seconds = static_cast<double>(Bench::ThreadCpuNs() - start_ns) / 1e9;
+        std::printf("%-28s transitions %10llu | %8.1f M/s | %5.2f ns each | actions %llu\n",
+                    has_progress ? "with progress" : "plain", static_cast<unsigned long long>(transitions),
+                    static_cast<double>(transitions) / seconds / 1e6, seconds * 1e9 / static_cast<double>(transitions),
+                    static_cast<unsigned long long>(actions));
+    }
+}
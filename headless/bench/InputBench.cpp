@@ -0,0 +1,107 @@
+#include "Bench.h"
+
+// Input as the hook hands it over: looked up in the published snapshot, then queued for the render thread.
+
+namespace {
+    void PushMoves(const int a_count) {
+        const auto manager = MANAGER(ImGui::Renderer);
+        const auto snapshot = manager->GetSnapshot();
+        for (int m = 0; m < a_count; ++m) {
+            for (const auto& a_entry : snapshot->Find(SkyPromptAPI::kMouseMove)) {
+                manager->PushInput({.type = ImGui::Renderer::InputCommand::Type::kMove,
+                                   .manager = a_entry.manager, .managerID = a_entry.managerID,
+                                   .delta = {1.f, -1.f}, .moving = true});
+            }
+        }
+    }
+}
+
+BENCH_SCENARIO(move, "--moves mouse moves per frame into --prompts kMouseMove prompts, without and with coalescing") {
+    using Key = std::pair<RE::INPUT_DEVICE, SkyPromptAPI::ButtonID>;
+    std::vector<std::unique_ptr<TestSink>> sinks;
+    const auto client = SkyPromptAPI::RequestClientID();
+    for (int i = 0; i < std::max(a_options.prompts, 1); ++i) {
+        sinks.push_back(std::make_unique<TestSink>(std::vector<TestSink::Spec>{
+            {.text = "Look", .event = static_cast<SkyPromptAPI::EventID>(i % a_options.slots + 1),
+             .action = static_cast<SkyPromptAPI::ActionID>(i + 1), .type = SkyPromptAPI::kHintHold,
+             .keys = {Key{RE::INPUT_DEVICE::kMouse, SkyPromptAPI::kMouseMove}}}}));
+        (void)SkyPromptAPI::SendPrompt(sinks.back().get(), client);
+    }
+
+    for (const bool coalesce : {false, true}) {
+        Theme::last_theme->coalesce_move = coalesce;
+        for (int i = 0; i < 10; ++i) {
+            PushMoves(a_options.moves);
+            Headless::Tick();
+        }
+        for (const auto& a_sink : sinks) {
+            a_sink->ClearEvents();
+        }
+
+        Bench::FrameStats frame;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < a_options.frames; ++i) {
+            frame.Begin();
+            PushMoves(a_options.moves);
+            Headless::Tick();
+            frame.End();
+        }
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        size_t events = 0;
+        for (const auto& a_sink : sinks) {
+            events += a_sink->Count(SkyPromptAPI::kMove);
+        }
+        frame.Print(coalesce ? "coalesced" : "one event per move");
+        std::printf("%-28s moves in %8.0f/s | kMove out %8.0f/s | %6.2f per frame\n", "",
+                    static_cast<double>(a_options.moves) * a_options.frames / seconds,
+                    static_cast<double>(events) / seconds, static_cast<double>(events) / a_options.frames);
+    }
+}
+
+BENCH_SCENARIO(buttons, "--moves key presses and releases per frame through RouteInput onto --slots visible keys") {
+    const auto slots = static_cast<uint32_t>(a_options.slots);
+    Bench::Population population(a_options, a_options.slots);
+    population.SendAll();
+    Headless::Tick();
+    Headless::Tick();
+
+    const auto manager = MANAGER(ImGui::Renderer);
+    Bench::FrameStats route;
+    Bench::FrameStats apply;
+    size_t edges = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < a_options.frames; ++i) {
+        route.Begin();
+        for (int m = 0; m < a_options.moves; ++m) {
+            const auto n = static_cast<uint32_t>(m);
+            // each key goes down, then up, then down again on its next turn
+            const bool pressed = (n / slots) % 2 == 0;
+            // as the hook does it: one pin of the snapshot per event
+            const auto snapshot = manager->GetSnapshot();
+            (void)manager->RouteInput(*snapshot, {.type = ImGui::Renderer::KeyInput::Type::kButton,
+                                                  .key = KEY::kNum1 + n % slots, .pressed = pressed,
+                                                  .down = pressed, .up = !pressed,
+                                                  .time = std::chrono::steady_clock::now()});
+        }
+        route.End();
+        apply.Begin();
+        Headless::Tick();
+        apply.End();
+        for (const auto& a_sink : population.sinks) {
+            edges += a_sink->Count(SkyPromptAPI::kDown) + a_sink->Count(SkyPromptAPI::kUp);
+            a_sink->ClearEvents();
+        }
+    }
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    route.Print("route (input thread)");
+    apply.Print("apply (frame)");
+    const auto per_event = [&](const double a_value) {
+        return a_options.moves ? a_value / a_options.moves : 0.0;
+    };
+    // every press and release should come out as kDown or kUp; fewer means input was dropped
+    std::printf("%-28s events in %8.0f/s | per event: locks %5.2f allocs %5.2f | kDown + kUp out %7.1f per frame\n",
+                "", static_cast<double>(a_options.moves) * a_options.frames / seconds, per_event(route.MeanLocks()),
+                per_event(route.MeanAllocations()), static_cast<double>(edges) / a_options.frames);
+}
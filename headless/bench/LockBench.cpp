@@ -0,0 +1,107 @@
+#include "Bench.h"
+
+// Who waits on whom: the render thread drawing frames, --producers threads calling the API and one input thread
+// reading the snapshot and queueing presses, all at once and without pauses, so any lock they share shows up.
+
+namespace {
+    struct Role {
+        std::string_view name;
+        uint64_t ops = 0;
+        Counters::Snapshot counters;
+
+        void Print() const {
+            const auto per_op = [this](const uint64_t a_value) {
+                return ops ? static_cast<double>(a_value) / static_cast<double>(ops) : 0.0;
+            };
+            std::printf("%-28.*s ops %9llu | locks/op %6.2f | contended %8llu (%5.2f%%) | wait us total %10.1f "
+                        "per contended %7.2f\n",
+                        static_cast<int>(name.size()), name.data(), static_cast<unsigned long long>(ops),
+                        per_op(counters.locks), static_cast<unsigned long long>(counters.contended),
+                        counters.locks ? 100.0 * static_cast<double>(counters.contended) /
+                                         static_cast<double>(counters.locks) : 0.0,
+                        static_cast<double>(counters.wait_ns) / 1000.0,
+                        counters.contended ? static_cast<double>(counters.wait_ns) / 1000.0 /
+                                             static_cast<double>(counters.contended) : 0.0);
+        }
+    };
+}
+
+BENCH_SCENARIO(contention, "--frames frames against --producers API threads and an input thread, all unthrottled") {
+    const auto producers = std::max(a_options.producers, 1);
+    Bench::Options per_thread = a_options;
+    per_thread.clients = 1;
+    // what the input thread presses: always on screen
+    Bench::Population resident(per_thread, a_options.slots);
+    resident.SendAll();
+    Headless::Tick();
+
+    std::vector<std::unique_ptr<Bench::Population>> populations;
+    for (int i = 0; i < producers; ++i) {
+        populations.push_back(std::make_unique<Bench::Population>(per_thread,
+                                                                  std::max(a_options.prompts / producers, 1)));
+    }
+
+    std::atomic<bool> stop = false;
+    std::vector<Role> roles(static_cast<size_t>(producers) + 2);
+    std::vector<std::jthread> threads;
+    for (int i = 0; i < producers; ++i) {
+        threads.emplace_back([&, i] {
+            const auto& population = *populations[static_cast<size_t>(i)];
+            auto& role = roles[static_cast<size_t>(i) + 2];
+            role.name = "send + remove (producer)";
+            const auto start = Counters::Now();
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (size_t s = 0; s < population.sinks.size(); ++s) {
+                    (void)SkyPromptAPI::SendPrompt(population.sinks[s].get(), population.owners[s]);
+                    SkyPromptAPI::RemovePrompt(population.sinks[s].get(), population.owners[s]);
+                    ++role.ops;
+                }
+            }
+            role.counters = Counters::Now() - start;
+        });
+    }
+    threads.emplace_back([&] {
+        const auto manager = MANAGER(ImGui::Renderer);
+        auto& role = roles[1];
+        role.name = "lookup + press (input)";
+        const auto start = Counters::Now();
+        for (uint32_t key = 0; !stop.load(std::memory_order_relaxed); key = (key + 1) % a_options.slots) {
+            const auto snapshot = manager->GetSnapshot();
+            for (const auto& a_entry : snapshot->Find(KEY::kNum1 + key)) {
+                // a key held down, so the prompts stay where they are
+                manager->PushInput({.type = ImGui::Renderer::InputCommand::Type::kButton,
+                                   .manager = a_entry.manager, .managerID = a_entry.managerID,
+                                   .pressed = true, .time = std::chrono::steady_clock::now()});
+            }
+            ++role.ops;
+        }
+        role.counters = Counters::Now() - start;
+    });
+
+    auto& render = roles[0];
+    render.name = "frame (render)";
+    Bench::FrameStats frame;
+    const auto start = Counters::Now();
+    for (int i = 0; i < a_options.frames; ++i) {
+        frame.Begin();
+        Headless::Tick();
+        frame.End();
+        ++render.ops;
+    }
+    render.counters = Counters::Now() - start;
+    stop = true;
+    threads.clear();
+
+    frame.Print("frame");
+    render.Print();
+    roles[1].Print();
+    Role producer;
+    producer.name = "send + remove (producers)";
+    for (size_t i = 2; i < roles.size(); ++i) {
+        producer.ops += roles[i].ops;
+        producer.counters.locks += roles[i].counters.locks;
+        producer.counters.contended += roles[i].counters.contended;
+        producer.counters.wait_ns += roles[i].counters.wait_ns;
+    }
+    producer.Print();
+}
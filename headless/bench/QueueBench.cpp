@@ -0,0 +1,125 @@
+#include "Bench.h"
+
+// What a queue of buttons costs to hold, copy and walk, for InteractionButton and for the layout it replaced: an
+// owning std::string for the text, a std::map for the keys and the hot fields spread over the record.
+
+namespace {
+    // InteractionButton as it was, fields in their old order; only what copying and walking touch
+    struct LegacyButton {
+        struct Mutables {
+            std::string text;
+            uint32_t text_color;
+            float progress;
+            size_t source_hash = 0;
+        };
+
+        Interaction interaction;
+        mutable Mutables mutables;
+        SkyPromptAPI::PromptType type = SkyPromptAPI::PromptType::kSinglePress;
+        RE::ObjectRefHandle attached_object;
+        std::map<Input::DEVICE, uint32_t> keys;
+        int default_key_index = 0;
+        bool timing_out_sent = false;
+        mutable std::array<InteractionButton::Resolved, Input::DEVICE::kTotal> resolved{};
+
+        LegacyButton(const Interaction& a_interaction, Mutables a_mutables, std::map<Input::DEVICE, uint32_t> a_keys)
+            : interaction(a_interaction), mutables(std::move(a_mutables)), keys(std::move(a_keys)) {}
+
+        [[nodiscard]] uint32_t Key(const Input::DEVICE a_device) const {
+            const auto it = keys.find(a_device);
+            return it != keys.end() ? it->second : 0;
+        }
+    };
+
+    uint32_t Key(const InteractionButton& a_button, const Input::DEVICE a_device) {
+        return a_button.keys[a_device];
+    }
+
+    uint32_t Key(const LegacyButton& a_button, const Input::DEVICE a_device) {
+        return a_button.Key(a_device);
+    }
+
+    // longer than the small-string buffer, like most prompt texts
+    std::string Text(const int a_index) {
+        return std::format("Take the iron sword from the chest {}", a_index);
+    }
+
+    std::vector<InteractionButton> MakeButtons(const int a_count) {
+        std::vector<InteractionButton> buttons;
+        for (int i = 0; i < a_count; ++i) {
+            InteractionButton::Keys keys{};
+            keys[Input::DEVICE::kKeyboardMouse] = KEY::kE;
+            keys[Input::DEVICE::kGamepadDirectX] = static_cast<uint32_t>(i + 1);
+            buttons.emplace_back(Interaction(1, static_cast<ACTIONS::Action>(i + 1)),
+                                 ImGui::Renderer::ButtonMutables{0xFFFFFFFF, 0.f, PromptText::Ref(Text(i))},
+                                 SkyPromptAPI::kSinglePress, 0, keys, 0);
+        }
+        return buttons;
+    }
+
+    std::vector<LegacyButton> MakeLegacyButtons(const int a_count) {
+        std::vector<LegacyButton> buttons;
+        for (int i = 0; i < a_count; ++i) {
+            buttons.emplace_back(Interaction(1, static_cast<ACTIONS::Action>(i + 1)),
+                                 LegacyButton::Mutables{Text(i), 0xFFFFFFFF, 0.f, std::hash<std::string>{}(Text(i))},
+                                 std::map<Input::DEVICE, uint32_t>{
+                                     {Input::DEVICE::kKeyboardMouse, KEY::kE},
+                                     {Input::DEVICE::kGamepadDirectX, static_cast<uint32_t>(i + 1)}});
+        }
+        return buttons;
+    }
+
+    // how far into the record the fields ShowQueue and the input path read every frame reach
+    template <class Button>
+    size_t HotBytes(const Button& a_button) {
+        const auto base = reinterpret_cast<const char*>(&a_button);
+        const auto end = [base](const auto& a_field) {
+            return static_cast<size_t>(reinterpret_cast<const char*>(&a_field) - base) + sizeof(a_field);
+        };
+        return std::max({end(a_button.interaction), end(a_button.type), end(a_button.mutables.text_color),
+                         end(a_button.mutables.progress)});
+    }
+
+    template <class Button>
+    void Measure(const std::string_view a_label, const std::vector<Button>& a_buttons, const int a_rounds) {
+        const auto count = static_cast<double>(a_buttons.size());
+        const auto rounds = std::max(a_rounds, 1);
+        volatile uint64_t keep = 0;
+
+        // what GetButtons, ReArrange and a by-value Add2Q used to do with a whole queue
+        auto start_counters = Counters::Now();
+        auto start_ns = Bench::ThreadCpuNs();
+        for (int r = 0; r < rounds; ++r) {
+            const auto copy = a_buttons;
+            keep = keep + copy.size();
+        }
+        const auto copy_ns = static_cast<double>(Bench::ThreadCpuNs() - start_ns);
+        const auto copy_allocations = static_cast<double>((Counters::Now() - start_counters).allocations);
+
+        // what a frame reads of every button: the interaction to find it, then type, progress, color and key
+        start_ns = Bench::ThreadCpuNs();
+        for (int r = 0; r < rounds; ++r) {
+            uint64_t sum = 0;
+            for (const auto& a_button : a_buttons) {
+                sum += a_button.interaction.action + static_cast<uint64_t>(a_button.type) +
+                       a_button.mutables.text_color + static_cast<uint64_t>(a_button.mutables.progress) +
+                       Key(a_button, static_cast<Input::DEVICE>(r % Input::DEVICE::kTotal));
+            }
+            keep = keep + sum;
+        }
+        const auto walk_ns = static_cast<double>(Bench::ThreadCpuNs() - start_ns);
+
+        std::printf("%-28.*s size %4zu B | hot fields in first %3zu B | copy ns/button %7.2f allocs/button %5.2f | "
+                    "walk ns/button %6.2f\n",
+                    static_cast<int>(a_label.size()), a_label.data(), sizeof(Button), HotBytes(a_buttons.front()),
+                    copy_ns / rounds / count, copy_allocations / rounds / count, walk_ns / rounds / count);
+    }
+}
+
+BENCH_SCENARIO(queue, "size, copy and walk cost of a --prompts button queue over --frames rounds, old layout too") {
+    const auto count = std::max(a_options.prompts, 1);
+    const auto buttons = MakeButtons(count);
+    const auto legacy = MakeLegacyButtons(count);
+    Measure("map + std::string (before)", legacy, a_options.frames);
+    Measure("InteractionButton", buttons, a_options.frames);
+}
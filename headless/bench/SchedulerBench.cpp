@@ -0,0 +1,93 @@
+#include "Bench.h"
+#include "Service.h"
+
+// Who gets the slots when there are more prompts than slots: bursts of sinks with mixed priorities arrive faster than
+// the slots turn over, and each sink's wait from SendPrompt to its first frame on screen is counted in frames. Aging
+// runs on the wall clock, which a bench frame hardly moves, so this is the scheduler with next to no aging; the
+// in-game wait of a low priority sink is shorter.
+
+namespace {
+    constexpr std::array priorities = {0, 5, 10};
+    constexpr std::array<std::string_view, priorities.size()> priority_names = {"low (0)", "mid (5)", "high (10)"};
+    // frames between bursts, and how long a sink may wait before it counts as starved
+    constexpr int burst_every = 30;
+    constexpr int starved_after = 600;
+
+    struct Waiter {
+        std::unique_ptr<TestSink> sink;
+        size_t priority;
+        int sent;
+        int shown = -1;
+    };
+
+    int Percentile(std::vector<int> a_values, const double a_p) {
+        if (a_values.empty()) {
+            return 0;
+        }
+        const auto n = static_cast<size_t>(a_p * static_cast<double>(a_values.size() - 1));
+        std::ranges::nth_element(a_values, a_values.begin() + static_cast<std::ptrdiff_t>(n));
+        return a_values[n];
+    }
+}
+
+BENCH_SCENARIO(fairness, "bursts of --prompts sinks of three priorities every 30 frames into --slots slots, --frames "
+                         "long: frames to display p50/p99 and starved sinks per priority") {
+    // short enough that the slots turn over within a burst interval or two
+    MCP::Settings::lifetime = 0.25f;
+    const auto client = SkyPromptAPI::RequestClientID();
+    std::vector<Waiter> waiters;
+    size_t next_unshown = 0;
+
+    int frame = 0;
+    const auto last_frame = a_options.frames + starved_after;
+    for (; frame < last_frame; ++frame) {
+        if (frame < a_options.frames && frame % burst_every == 0) {
+            for (int i = 0; i < a_options.prompts; ++i) {
+                const auto priority = waiters.size() % priorities.size();
+                auto sink = std::make_unique<TestSink>(std::vector<TestSink::Spec>{
+                    {.text = std::format("Prompt {}", waiters.size()),
+                     .event = static_cast<SkyPromptAPI::EventID>(waiters.size() + 1), .action = 1}});
+                (void)ProcessSetPromptPriority(sink.get(), client, priorities[priority]);
+                (void)SkyPromptAPI::SendPrompt(sink.get(), client);
+                waiters.push_back({std::move(sink), priority, frame});
+            }
+        }
+        Headless::Tick();
+        for (size_t i = next_unshown; i < waiters.size(); ++i) {
+            if (auto& waiter = waiters[i]; waiter.shown < 0 &&
+                                           MANAGER(ImGui::Renderer)->IsInQueue(client, waiter.sink.get())) {
+                waiter.shown = frame;
+            }
+        }
+        while (next_unshown < waiters.size() && waiters[next_unshown].shown >= 0) {
+            ++next_unshown;
+        }
+        // past the last burst, run only until everyone was shown
+        if (frame >= a_options.frames && next_unshown == waiters.size()) {
+            break;
+        }
+    }
+
+    for (size_t p = 0; p < priorities.size(); ++p) {
+        std::vector<int> waits;
+        size_t count = 0;
+        size_t starved = 0;
+        for (const auto& waiter : waiters) {
+            if (waiter.priority != p) {
+                continue;
+            }
+            ++count;
+            const auto wait = (waiter.shown >= 0 ? waiter.shown : frame) - waiter.sent;
+            starved += waiter.shown < 0 || wait > starved_after;
+            if (waiter.shown >= 0) {
+                waits.push_back(wait);
+            }
+        }
+        std::printf("%-10.*s sinks %5zu | frames to display p50 %5d p99 %5d max %5d | starved (> %d frames or never) "
+                    "%5zu\n",
+                    static_cast<int>(priority_names[p].size()), priority_names[p].data(), count,
+                    Percentile(waits, 0.5), Percentile(waits, 0.99), Percentile(waits, 1.0), starved_after,
+                    starved);
+    }
+    std::printf("ran %d frames, %d after the last burst\n", frame, std::max(frame - a_options.frames, 0));
+}
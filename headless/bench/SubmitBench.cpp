@@ -0,0 +1,89 @@
+#include "Bench.h"
+
+// Mods calling the API from their own threads while the render thread draws.
+
+BENCH_SCENARIO(producers, "--producers threads send and remove their share of --prompts while frames run") {
+    const auto producers = std::max(a_options.producers, 1);
+    Bench::Options per_thread = a_options;
+    per_thread.clients = 1;
+    std::vector<std::unique_ptr<Bench::Population>> populations;
+    for (int i = 0; i < producers; ++i) {
+        populations.push_back(std::make_unique<Bench::Population>(per_thread,
+                                                                  std::max(a_options.prompts / producers, 1)));
+    }
+
+    std::atomic<bool> stop = false;
+    std::vector<std::vector<uint64_t>> latencies(static_cast<size_t>(producers));
+    std::vector<std::jthread> threads;
+    for (int i = 0; i < producers; ++i) {
+        threads.emplace_back([&, i] {
+            const auto& population = *populations[static_cast<size_t>(i)];
+            auto& latency = latencies[static_cast<size_t>(i)];
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (size_t s = 0; s < population.sinks.size(); ++s) {
+                    const auto start = std::chrono::steady_clock::now();
+                    (void)SkyPromptAPI::SendPrompt(population.sinks[s].get(), population.owners[s]);
+                    SkyPromptAPI::RemovePrompt(population.sinks[s].get(), population.owners[s]);
+                    latency.push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start).count()));
+                }
+                // roughly a game frame's worth of script work between rounds
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        });
+    }
+
+    Bench::FrameStats frame;
+    for (int i = 0; i < a_options.frames; ++i) {
+        frame.Begin();
+        Headless::Tick();
+        frame.End();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    stop = true;
+    threads.clear();
+    frame.Print("frame");
+
+    std::vector<uint64_t> all;
+    for (const auto& a_latency : latencies) {
+        all.insert(all.end(), a_latency.begin(), a_latency.end());
+    }
+    if (all.empty()) {
+        return;
+    }
+    std::ranges::sort(all);
+    std::printf("%-28s calls  %6zu | wall us p50 %8.2f p99 %8.2f max %8.2f\n", "send + remove (producers)",
+                all.size(), static_cast<double>(all[all.size() / 2]) / 1000.0,
+                static_cast<double>(all[all.size() * 99 / 100]) / 1000.0, static_cast<double>(all.back()) / 1000.0);
+}
+
+BENCH_SCENARIO(resend, "every frame all --prompts sinks are sent again with new progress, then with new text") {
+    Bench::Population population(a_options, a_options.prompts);
+    population.SendAll();
+    for (int i = 0; i < 10; ++i) {
+        Headless::Tick();
+    }
+
+    for (const bool text : {false, true}) {
+        Bench::FrameStats api;
+        Bench::FrameStats frame;
+        for (int i = 0; i < a_options.frames; ++i) {
+            // what a mod showing a progress bar does every frame; the text only changes in the second run
+            for (size_t s = 0; s < population.sinks.size(); ++s) {
+                auto& sink = *population.sinks[s];
+                sink.SetProgress(0, static_cast<float>(i % 100) / 100.f);
+                if (text) {
+                    sink.SetText(0, std::format("Prompt {} ({}%)", s, i % 100));
+                }
+            }
+            api.Begin();
+            population.SendAll();
+            api.End();
+            frame.Begin();
+            Headless::Tick();
+            frame.End();
+        }
+        api.Print(text ? "resend, new text (caller)" : "resend, progress (caller)");
+        frame.Print(text ? "frame applying new text" : "frame applying progress");
+    }
+}
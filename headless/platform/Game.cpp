@@ -0,0 +1,103 @@
+// Link-time stand-ins for the plugin's game, UI and ImGui code that the prompt core references but the headless build
+// does not compile.
+#include "Headless.h"
+#include "IconsFonts.h"
+#include "Styles.h"
+#include "Utils.h"
+
+namespace {
+    std::mutex tasks_mutex;
+    std::vector<std::function<void()>> tasks;
+}
+
+std::optional<std::filesystem::path> SKSE::log::log_directory() {
+    return std::filesystem::temp_directory_path();
+}
+
+void SKSE::stl::report_and_fail(const std::string_view a_message) {
+    spdlog::critical("{}", a_message);
+    std::abort();
+}
+
+const SKSE::PluginDeclaration* SKSE::PluginDeclaration::GetSingleton() {
+    static const PluginDeclaration declaration;
+    return &declaration;
+}
+
+void SKSE::TaskInterface::AddTask(std::function<void()> a_task) const {
+    std::lock_guard lock(tasks_mutex);
+    tasks.push_back(std::move(a_task));
+}
+
+const SKSE::TaskInterface* SKSE::GetTaskInterface() {
+    static const TaskInterface task_interface;
+    return &task_interface;
+}
+
+size_t SKSE::RunTasks() {
+    std::vector<std::function<void()>> batch;
+    {
+        std::lock_guard lock(tasks_mutex);
+        if (tasks.empty()) {
+            return 0;
+        }
+        batch.swap(tasks);
+    }
+    for (const auto& a_task : batch) {
+        a_task();
+    }
+    return batch.size();
+}
+
+void TranslateEmbedded(std::string&) {}
+
+void BeginImGuiWindow(const char*) {}
+
+void EndImGuiWindow() {}
+
+void SkyrimMessageBox::Show(const std::string&, const std::vector<std::string>&, std::function<void(unsigned int)>) {}
+
+ImGui::Texture::Texture(const std::wstring_view a_folder, const std::wstring_view a_textureName)
+    : path(std::wstring(a_folder) + std::wstring(a_textureName)) {}
+
+ImGui::Texture::Texture(const std::wstring_view a_path) : path(a_path) {}
+
+ImGui::Texture::~Texture() = default;
+
+bool ImGui::Texture::Load(bool) {
+    return true;
+}
+
+IconFont::IconTexture::IconTexture(const std::wstring_view a_iconName) : Texture(a_iconName) {}
+
+bool IconFont::IconTexture::Load(bool) {
+    return true;
+}
+
+void ImGui::Styles::RefreshStyle() {}
+
+Input::DEVICE Input::Manager::GetInputDevice() const {
+    return inputDevice;
+}
+
+uint32_t Input::Manager::Convert(const uint32_t button_key, const RE::INPUT_DEVICE a_device) {
+    using namespace SKSE::InputMap;
+    if (a_device == RE::INPUT_DEVICE::kMouse && button_key < kMacro_MouseButtonOffset) {
+        return button_key + kMacro_MouseButtonOffset;
+    }
+    return button_key;
+}
+
+Input::DEVICE Input::from_RE_device(const RE::INPUT_DEVICE a_device) {
+    switch (a_device) {
+        case RE::INPUT_DEVICE::kKeyboard:
+        case RE::INPUT_DEVICE::kMouse:
+            return DEVICE::kKeyboardMouse;
+        case RE::INPUT_DEVICE::kGamepad:
+            return DEVICE::kGamepadDirectX;
+        default:
+            return DEVICE::kUnknown;
+    }
+}
+
+void Theme::Theme::ReLoad(std::string_view) {}
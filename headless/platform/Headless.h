@@ -0,0 +1,29 @@
+#pragma once
+#include "Renderer.h"
+
+// Controls for the stand-in game the headless core runs against. Everything here is meant for one host thread, the
+// one that calls Tick, like the game's render thread in the plugin.
+namespace Headless {
+    // what RenderSkyPrompt was handed since the last ResetDraws
+    struct DrawStats {
+        uint64_t batches = 0;
+        uint64_t prompts = 0;
+        std::vector<std::string> last_texts; // only with RecordTexts
+    };
+
+    // default prompt keys for a_slots slots on every device, one key per slot, and the start-up reloads done
+    void Init(int a_slots = 8);
+    void SetFrameDelta(float a_seconds);
+    void SetGameFrozen(bool a_frozen);
+    // a reference LookupRef resolves, placed at a_x, a_y on screen
+    RE::TESObjectREFR* AddReference(RefID a_refid, float a_x = 0.f, float a_y = 0.f);
+
+    [[nodiscard]] const DrawStats& Draws();
+    void ResetDraws();
+    // keep the texts of the last batch in DrawStats; off by default since copying them allocates
+    void RecordTexts(bool a_record);
+
+    // one frame as the draw hook runs it: queued game tasks first, then RenderPrompts unless the frame is idle.
+    // Returns whether RenderPrompts ran.
+    bool Tick();
+}
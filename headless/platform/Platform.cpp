@@ -0,0 +1,124 @@
+#include "Headless.h"
+#include "IconsFonts.h"
+
+using namespace ImGui::Renderer;
+
+namespace {
+    float frame_delta = 1.f / 60.f;
+    bool game_frozen = false;
+    std::map<RefID, std::unique_ptr<RE::TESObjectREFR>> references;
+    Headless::DrawStats draws;
+    bool record_texts = false;
+
+    // every key has an icon in the headless build; the texture itself is never drawn
+    const IconFont::IconTexture& HeadlessIcon() {
+        static const IconFont::IconTexture icon(L"Headless"sv);
+        return icon;
+    }
+}
+
+void Headless::Init(const int a_slots) {
+    using Input::DEVICE;
+    for (const auto device : {DEVICE::kKeyboardMouse, DEVICE::kGamepadDirectX, DEVICE::kGamepadOrbis}) {
+        auto& keys = MCP::Settings::prompt_keys[device];
+        keys.clear();
+        for (int i = 0; i < a_slots; ++i) {
+            keys.push_back(static_cast<uint32_t>(KEY::kNum1 + i));
+        }
+    }
+    Theme::default_theme.n_max_buttons = a_slots;
+    MCP::Settings::bindings_version.fetch_add(1);
+    // the plugin spends its first frames on these; start past them so frame counts mean the same in every test
+    MCP::Settings::shouldReloadLifetime = false;
+    MCP::Settings::shouldReloadPromptSize = false;
+}
+
+void Headless::SetFrameDelta(const float a_seconds) {
+    frame_delta = a_seconds;
+}
+
+void Headless::SetGameFrozen(const bool a_frozen) {
+    game_frozen = a_frozen;
+}
+
+RE::TESObjectREFR* Headless::AddReference(const RefID a_refid, const float a_x, const float a_y) {
+    auto& ref = references[a_refid];
+    if (!ref) {
+        ref = std::make_unique<RE::TESObjectREFR>();
+        ref->formID = a_refid;
+    }
+    ref->position = {a_x, a_y, 0.f};
+    return ref.get();
+}
+
+const Headless::DrawStats& Headless::Draws() {
+    return draws;
+}
+
+void Headless::ResetDraws() {
+    draws = {};
+}
+
+void Headless::RecordTexts(const bool a_record) {
+    record_texts = a_record;
+}
+
+bool Headless::Tick() {
+    SKSE::RunTasks();
+    if (MANAGER(ImGui::Renderer)->GetFrameDemand().Idle()) {
+        return false;
+    }
+    RenderPrompts();
+    return true;
+}
+
+float ImGui::Renderer::GetResolutionScale() {
+    return DisplayTweaks::resolutionScale;
+}
+
+float Platform::GetSecondsSinceLastFrame() {
+    return frame_delta;
+}
+
+RE::ObjectRefHandle Platform::LookupRef(const RefID a_refid) {
+    if (const auto it = references.find(a_refid); it != references.end()) {
+        return it->second->GetHandle();
+    }
+    return {};
+}
+
+const IconFont::IconTexture* Platform::LookupIcon(const uint32_t a_key) {
+    return a_key ? &HeadlessIcon() : nullptr;
+}
+
+bool Platform::IsGameFrozen() {
+    return game_frozen;
+}
+
+ImVec2 Platform::GetScreenSize() {
+    return ImGui::GetIO().DisplaySize;
+}
+
+ImVec2 Platform::GetAttachedObjectPos(RE::TESObjectREFR* a_ref) {
+    if (!a_ref) {
+        return {};
+    }
+    return {a_ref->position.x, a_ref->position.y};
+}
+
+void ImGui::RenderSkyPrompt() {
+    if (renderBatch.empty()) {
+        return;
+    }
+    ++draws.batches;
+    draws.prompts += renderBatch.size();
+    if (!record_texts) {
+        return;
+    }
+    draws.last_texts.clear();
+    for (const auto& a_info : renderBatch) {
+        draws.last_texts.emplace_back(a_info.text);
+    }
+}
+
+void ImGui::DrawCycleIndicators(SkyPromptAPI::ClientID, SkyPromptAPI::ClientID) {}
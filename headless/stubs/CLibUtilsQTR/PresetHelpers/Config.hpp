@@ -0,0 +1,15 @@
+#pragma once
+#include <string_view>
+#include <utility>
+
+namespace Presets {
+    template <class T, class V>
+    struct Field {
+        std::string_view name;
+        T value;
+
+        Field(const std::string_view a_name, T a_value) : name(a_name), value(std::move(a_value)) {}
+
+        void load(V&) {}
+    };
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <string>
+
+// every lookup falls back to its default
+class CSimpleIniA {
+public:
+    void SetUnicode(bool = true) {}
+    int LoadFile(const char*) { return -1; }
+    [[nodiscard]] double GetDoubleValue(const char*, const char*, const double a_default = 0.0) const {
+        return a_default;
+    }
+    [[nodiscard]] bool GetBoolValue(const char*, const char*, const bool a_default = false) const { return a_default; }
+};
+
+namespace clib_util::ini {
+    inline std::string get_value(const CSimpleIniA&, std::string& a_default, const char*, const char*) {
+        return a_default;
+    }
+}
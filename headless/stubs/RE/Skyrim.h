@@ -0,0 +1,435 @@
+#pragma once
+// Stand-in for the slice of CommonLibSSE the prompt core compiles against. Only layouts and behaviour the core relies
+// on are modelled; nothing here talks to a game.
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <set>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <xmmintrin.h>
+
+// older standard libraries (GCC 12) have no <format>; fmt has the same interface for what the core uses
+#if __has_include(<format>)
+#include <format>
+#else
+#include <fmt/format.h>
+namespace std {
+    using fmt::format;
+    using fmt::format_to;
+    using fmt::format_string;
+}
+#endif
+
+#if !defined(_MSC_VER)
+    #define __stdcall
+    #define __declspec(x)
+#endif
+
+namespace REL {
+    template <class T>
+    class Relocation {
+    public:
+        Relocation() = default;
+    };
+
+    struct VariantID {};
+}
+
+namespace RE {
+    using FormID = std::uint32_t;
+
+    enum class BSEventNotifyControl {
+        kContinue,
+        kStop
+    };
+
+    enum INPUT_DEVICE : std::uint32_t {
+        kNone = static_cast<std::uint32_t>(-1),
+        kKeyboard = 0,
+        kMouse,
+        kGamepad,
+        kVirtualKeyboard,
+        kTotal
+    };
+
+    enum class INPUT_EVENT_TYPE : std::uint32_t {
+        kButton,
+        kMouseMove,
+        kChar,
+        kThumbstick,
+        kDeviceConnect,
+        kKinect
+    };
+
+    struct BSWin32KeyboardDevice {
+        enum Key : std::uint32_t {
+            kEscape = 0x01,
+            kNum1,
+            kNum2,
+            kNum3,
+            kNum4,
+            kNum5,
+            kNum6,
+            kNum7,
+            kNum8,
+            kNum9,
+            kNum0,
+            kMinus,
+            kEquals,
+            kBackspace,
+            kTab,
+            kQ,
+            kW,
+            kE,
+            kR,
+            kT,
+            kY,
+            kU,
+            kI,
+            kO,
+            kP,
+            kBracketLeft,
+            kBracketRight,
+            kEnter,
+            kLeftControl,
+            kA,
+            kS,
+            kD,
+            kF,
+            kG,
+            kH,
+            kJ,
+            kK,
+            kL,
+            kSemicolon,
+            kApostrophe,
+            kTilde,
+            kLeftShift,
+            kBackslash,
+            kZ,
+            kX,
+            kC,
+            kV,
+            kB,
+            kN,
+            kM,
+            kComma,
+            kPeriod,
+            kSlash,
+            kRightShift,
+            kKP_Multiply,
+            kLeftAlt,
+            kSpacebar,
+            kCapsLock,
+            kF1,
+            kF2,
+            kF3,
+            kF4,
+            kF5,
+            kF6,
+            kF7,
+            kF8,
+            kF9,
+            kF10,
+            kNumLock,
+            kScrollLock,
+            kKP_7,
+            kKP_8,
+            kKP_9,
+            kKP_Subtract,
+            kKP_4,
+            kKP_5,
+            kKP_6,
+            kKP_Plus,
+            kKP_1,
+            kKP_2,
+            kKP_3,
+            kKP_0,
+            kKP_Decimal,
+            kF11 = 0x57,
+            kF12,
+            kKP_Enter = 0x9C,
+            kRightControl,
+            kKP_Divide = 0xB5,
+            kPrintScreen = 0xB7,
+            kRightAlt,
+            kPause = 0xC5,
+            kHome = 0xC7,
+            kUp,
+            kPageUp,
+            kLeft = 0xCB,
+            kRight = 0xCD,
+            kEnd = 0xCF,
+            kDown,
+            kPageDown,
+            kInsert,
+            kDelete,
+            kLeftWin = 0xDB,
+            kRightWin
+        };
+    };
+
+    struct BSWin32MouseDevice {
+        enum Key : std::uint32_t {
+            kLeftButton,
+            kRightButton,
+            kMiddleButton,
+            kButton3,
+            kButton4,
+            kButton5,
+            kButton6,
+            kButton7,
+            kWheelUp,
+            kWheelDown
+        };
+    };
+
+    struct BSWin32GamepadDevice {
+        enum Key : std::uint32_t {
+            kUp = 0x0001,
+            kDown = 0x0002,
+            kLeft = 0x0004,
+            kRight = 0x0008,
+            kStart = 0x0010,
+            kBack = 0x0020,
+            kLeftThumb = 0x0040,
+            kRightThumb = 0x0080,
+            kLeftShoulder = 0x0100,
+            kRightShoulder = 0x0200,
+            kA = 0x1000,
+            kB = 0x2000,
+            kX = 0x4000,
+            kY = 0x8000,
+            kLeftTrigger = 0x0009,
+            kRightTrigger = 0x000A
+        };
+    };
+
+    struct BSPCOrbisGamepadDevice {
+        using Key = BSWin32GamepadDevice::Key;
+    };
+
+    struct NiPoint3 {
+        float x = 0.f;
+        float y = 0.f;
+        float z = 0.f;
+
+        constexpr NiPoint3() = default;
+        constexpr NiPoint3(const float a_x, const float a_y, const float a_z) : x(a_x), y(a_y), z(a_z) {}
+
+        NiPoint3 operator+(const NiPoint3& a_rhs) const { return {x + a_rhs.x, y + a_rhs.y, z + a_rhs.z}; }
+        NiPoint3 operator-(const NiPoint3& a_rhs) const { return {x - a_rhs.x, y - a_rhs.y, z - a_rhs.z}; }
+        NiPoint3 operator*(const float a_scalar) const { return {x * a_scalar, y * a_scalar, z * a_scalar}; }
+        NiPoint3& operator*=(const float a_scalar) {
+            x *= a_scalar;
+            y *= a_scalar;
+            z *= a_scalar;
+            return *this;
+        }
+    };
+
+    struct hkVector4 {
+        __m128 quad{};
+    };
+
+    class bhkRigidBody {
+    public:
+        void GetPosition(hkVector4& a_out) const { a_out.quad = _mm_setzero_ps(); }
+    };
+
+    class NiCollisionObject {
+    public:
+        [[nodiscard]] bhkRigidBody* GetRigidBody() const { return nullptr; }
+    };
+
+    class NiAVObject {
+    public:
+        [[nodiscard]] NiCollisionObject* GetCollisionObject() const { return nullptr; }
+    };
+
+    template <class T>
+    class NiPointer {
+    public:
+        NiPointer() = default;
+        explicit NiPointer(T* a_ptr) : ptr_(a_ptr) {}
+
+        [[nodiscard]] T* get() const { return ptr_; }
+        T* operator->() const { return ptr_; }
+        explicit operator bool() const { return ptr_ != nullptr; }
+
+    private:
+        T* ptr_ = nullptr;
+    };
+
+    class TESForm {
+    public:
+        virtual ~TESForm() = default;
+
+        [[nodiscard]] FormID GetFormID() const { return formID; }
+
+        FormID formID = 0;
+    };
+
+    class TESObjectREFR;
+
+    // the game resolves handles through a table; here a handle is the reference itself
+    class ObjectRefHandle {
+    public:
+        ObjectRefHandle() = default;
+        explicit ObjectRefHandle(TESObjectREFR* a_ref) : ref_(a_ref) {}
+
+        [[nodiscard]] NiPointer<TESObjectREFR> get() const { return NiPointer<TESObjectREFR>(ref_); }
+        explicit operator bool() const { return ref_ != nullptr; }
+
+    private:
+        TESObjectREFR* ref_ = nullptr;
+    };
+
+    class TESObjectREFR : public TESForm {
+    public:
+        [[nodiscard]] ObjectRefHandle GetHandle() { return ObjectRefHandle(this); }
+        [[nodiscard]] NiAVObject* Get3D() const { return nullptr; }
+        [[nodiscard]] NiPoint3 GetPosition() const { return position; }
+        [[nodiscard]] float GetScale() const { return 1.f; }
+
+        NiPoint3 position;
+    };
+
+    class ButtonEvent;
+    class MouseMoveEvent;
+    class ThumbstickEvent;
+
+    class InputEvent {
+    public:
+        virtual ~InputEvent() = default;
+
+        [[nodiscard]] INPUT_DEVICE GetDevice() const { return device; }
+        [[nodiscard]] INPUT_EVENT_TYPE GetEventType() const { return eventType; }
+
+        [[nodiscard]] ButtonEvent* AsButtonEvent();
+        [[nodiscard]] const ButtonEvent* AsButtonEvent() const;
+        [[nodiscard]] MouseMoveEvent* AsMouseMoveEvent();
+        [[nodiscard]] const MouseMoveEvent* AsMouseMoveEvent() const;
+        [[nodiscard]] ThumbstickEvent* AsThumbstickEvent();
+        [[nodiscard]] const ThumbstickEvent* AsThumbstickEvent() const;
+
+        INPUT_DEVICE device = kKeyboard;
+        INPUT_EVENT_TYPE eventType = INPUT_EVENT_TYPE::kButton;
+        InputEvent* next = nullptr;
+    };
+
+    class IDEvent : public InputEvent {
+    public:
+        [[nodiscard]] std::uint32_t GetIDCode() const { return idCode; }
+
+        std::uint32_t idCode = 0;
+    };
+
+    class ButtonEvent : public IDEvent {
+    public:
+        [[nodiscard]] float Value() const { return value; }
+        [[nodiscard]] float HeldDuration() const { return heldDownSecs; }
+        [[nodiscard]] bool IsPressed() const { return value > 0.f; }
+        [[nodiscard]] bool IsDown() const { return value > 0.f && heldDownSecs == 0.f; }
+        [[nodiscard]] bool IsUp() const { return value == 0.f && heldDownSecs > 0.f; }
+
+        float value = 0.f;
+        float heldDownSecs = 0.f;
+    };
+
+    class MouseMoveEvent : public IDEvent {
+    public:
+        std::int32_t mouseInputX = 0;
+        std::int32_t mouseInputY = 0;
+    };
+
+    class ThumbstickEvent : public IDEvent {
+    public:
+        enum InputType : std::uint32_t {
+            kLeftThumbstick = 0x0B,
+            kRightThumbstick = 0x0C
+        };
+
+        [[nodiscard]] bool IsLeft() const { return idCode == kLeftThumbstick; }
+
+        float xValue = 0.f;
+        float yValue = 0.f;
+    };
+
+    inline ButtonEvent* InputEvent::AsButtonEvent() {
+        return eventType == INPUT_EVENT_TYPE::kButton ? static_cast<ButtonEvent*>(this) : nullptr;
+    }
+
+    inline const ButtonEvent* InputEvent::AsButtonEvent() const {
+        return eventType == INPUT_EVENT_TYPE::kButton ? static_cast<const ButtonEvent*>(this) : nullptr;
+    }
+
+    inline MouseMoveEvent* InputEvent::AsMouseMoveEvent() {
+        return eventType == INPUT_EVENT_TYPE::kMouseMove ? static_cast<MouseMoveEvent*>(this) : nullptr;
+    }
+
+    inline const MouseMoveEvent* InputEvent::AsMouseMoveEvent() const {
+        return eventType == INPUT_EVENT_TYPE::kMouseMove ? static_cast<const MouseMoveEvent*>(this) : nullptr;
+    }
+
+    inline ThumbstickEvent* InputEvent::AsThumbstickEvent() {
+        return eventType == INPUT_EVENT_TYPE::kThumbstick ? static_cast<ThumbstickEvent*>(this) : nullptr;
+    }
+
+    inline const ThumbstickEvent* InputEvent::AsThumbstickEvent() const {
+        return eventType == INPUT_EVENT_TYPE::kThumbstick ? static_cast<const ThumbstickEvent*>(this) : nullptr;
+    }
+
+    template <class Event>
+    class BSTEventSource;
+
+    enum class UI_MESSAGE_RESULTS : std::uint32_t {
+        kHandled,
+        kIgnore,
+        kPassOn
+    };
+
+    class UIMessage;
+
+    class IMessageBoxCallback {
+    public:
+        enum class Message : std::uint8_t {
+            kUnk0,
+            kUnk1,
+            kUnk2,
+            kUnk3
+        };
+
+        virtual ~IMessageBoxCallback() = default;
+        virtual void Run(Message a_msg) = 0;
+    };
+}
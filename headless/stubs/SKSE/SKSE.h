@@ -0,0 +1,96 @@
+#pragma once
+// Stand-in for the SKSE interfaces the prompt core uses: logging through spdlog, the plugin declaration and a task
+// interface whose queue the host drains explicitly (SKSE::RunTasks) instead of on the game's main thread.
+#include <spdlog/spdlog.h>
+#include "RE/Skyrim.h"
+#include "REX/REX/Singleton.h"
+
+namespace SKSE {
+    namespace log {
+        template <class... Args>
+        void trace(fmt::format_string<Args...> a_fmt, Args&&... a_args) {
+            spdlog::trace(a_fmt, std::forward<Args>(a_args)...);
+        }
+
+        template <class... Args>
+        void debug(fmt::format_string<Args...> a_fmt, Args&&... a_args) {
+            spdlog::debug(a_fmt, std::forward<Args>(a_args)...);
+        }
+
+        template <class... Args>
+        void info(fmt::format_string<Args...> a_fmt, Args&&... a_args) {
+            spdlog::info(a_fmt, std::forward<Args>(a_args)...);
+        }
+
+        template <class... Args>
+        void warn(fmt::format_string<Args...> a_fmt, Args&&... a_args) {
+            spdlog::warn(a_fmt, std::forward<Args>(a_args)...);
+        }
+
+        template <class... Args>
+        void error(fmt::format_string<Args...> a_fmt, Args&&... a_args) {
+            spdlog::error(a_fmt, std::forward<Args>(a_args)...);
+        }
+
+        template <class... Args>
+        void critical(fmt::format_string<Args...> a_fmt, Args&&... a_args) {
+            spdlog::critical(a_fmt, std::forward<Args>(a_args)...);
+        }
+
+        std::optional<std::filesystem::path> log_directory();
+    }
+
+    namespace stl {
+        [[noreturn]] void report_and_fail(std::string_view a_message);
+    }
+
+    class PluginDeclaration {
+    public:
+        static const PluginDeclaration* GetSingleton();
+        [[nodiscard]] std::string_view GetName() const { return "SkyPrompt"; }
+    };
+
+    class TaskInterface {
+    public:
+        void AddTask(std::function<void()> a_task) const;
+    };
+
+    const TaskInterface* GetTaskInterface();
+    // runs the tasks queued so far, in order; tasks they queue wait for the next call
+    size_t RunTasks();
+
+    namespace Translation {
+        inline bool Translate(const std::string&, std::string&) { return false; }
+    }
+
+    namespace InputMap {
+        enum : std::uint32_t {
+            kMacro_KeyboardOffset = 0,
+            kMacro_NumKeyboardKeys = 256,
+            kMacro_MouseButtonOffset = kMacro_NumKeyboardKeys,
+            kMacro_NumMouseButtons = 8,
+            kMacro_MouseWheelOffset = kMacro_MouseButtonOffset + kMacro_NumMouseButtons,
+            kMacro_MouseWheelDirections = 2,
+            kMacro_GamepadOffset = kMacro_MouseWheelOffset + kMacro_MouseWheelDirections,
+            kMacro_NumGamepadButtons = 16,
+            kMaxMacros = kMacro_GamepadOffset + kMacro_NumGamepadButtons,
+
+            kGamepadButtonOffset_DPAD_UP = kMacro_GamepadOffset,
+            kGamepadButtonOffset_DPAD_DOWN,
+            kGamepadButtonOffset_DPAD_LEFT,
+            kGamepadButtonOffset_DPAD_RIGHT,
+            kGamepadButtonOffset_START,
+            kGamepadButtonOffset_BACK,
+            kGamepadButtonOffset_LEFT_THUMB,
+            kGamepadButtonOffset_RIGHT_THUMB,
+            kGamepadButtonOffset_LEFT_SHOULDER,
+            kGamepadButtonOffset_RIGHT_SHOULDER,
+            kGamepadButtonOffset_A,
+            kGamepadButtonOffset_B,
+            kGamepadButtonOffset_X,
+            kGamepadButtonOffset_Y,
+            kGamepadButtonOffset_LT,
+            kGamepadButtonOffset_RT
+        };
+    }
+}
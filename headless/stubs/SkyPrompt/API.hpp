@@ -0,0 +1,97 @@
+#pragma once
+// Stand-in for the public SkyPrompt API header. Same types and entry points; the entry points call the plugin's
+// exported functions directly because the headless build links the core into the same binary.
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace SkyPromptAPI {
+    constexpr int MAJOR = 2;
+    constexpr int MINOR = 0;
+
+    using ClientID = std::uint16_t;
+    using EventID = std::uint16_t;
+    using ActionID = std::uint16_t;
+    using ButtonID = std::uint32_t;
+
+    constexpr ButtonID kMouseMove = 1000;
+    constexpr ButtonID kThumbstickMoveL = 1001;
+    constexpr ButtonID kThumbstickMoveR = 1002;
+    constexpr ButtonID kSkyrim = 1003;
+
+    enum PromptType : std::uint8_t {
+        kSinglePress,
+        kHold,
+        kHoldAndKeep,
+        kHintHold,
+        kHintHoldAndKeep,
+        kTotalPromptTypes
+    };
+
+    enum PromptEventType : std::uint8_t {
+        kAccepted,
+        kDeclined,
+        kUp,
+        kDown,
+        kTimeout,
+        kTimingOut,
+        kRemovedByMod,
+        kMove,
+        kTotalEventTypes
+    };
+
+    struct Prompt {
+        std::string_view text;
+        EventID eventID = 0;
+        ActionID actionID = 0;
+        PromptType type = kSinglePress;
+        RE::FormID refid = 0;
+        std::span<const std::pair<RE::INPUT_DEVICE, ButtonID>> button_key;
+        std::uint32_t text_color = 0xFFFFFFFF;
+        float progress = 0.f;
+
+        constexpr Prompt() = default;
+
+        constexpr Prompt(const std::string_view a_text, const EventID a_eventID, const ActionID a_actionID,
+                         const PromptType a_type, const RE::FormID a_refid = 0,
+                         const std::span<const std::pair<RE::INPUT_DEVICE, ButtonID>> a_button_key = {},
+                         const std::uint32_t a_text_color = 0xFFFFFFFF, const float a_progress = 0.f)
+            : text(a_text), eventID(a_eventID), actionID(a_actionID), type(a_type), refid(a_refid),
+              button_key(a_button_key), text_color(a_text_color), progress(a_progress) {}
+    };
+
+    struct PromptEvent {
+        Prompt prompt;
+        PromptEventType type = kAccepted;
+        std::pair<float, float> delta{0.f, 0.f};
+    };
+
+    class PromptSink {
+    public:
+        virtual ~PromptSink() = default;
+        virtual void ProcessEvent(PromptEvent event) const = 0;
+        [[nodiscard]] virtual std::span<const Prompt> GetPrompts() const = 0;
+    };
+}
+
+extern "C" bool ProcessSendPrompt(const SkyPromptAPI::PromptSink* a_sink, SkyPromptAPI::ClientID a_clientID);
+extern "C" void ProcessRemovePrompt(const SkyPromptAPI::PromptSink* a_sink, SkyPromptAPI::ClientID a_clientID);
+extern "C" SkyPromptAPI::ClientID ProcessRequestClientID(int a_major, int a_minor);
+extern "C" bool ProcessRequestTheme(SkyPromptAPI::ClientID a_clientID, std::string_view theme_name);
+
+namespace SkyPromptAPI {
+    [[nodiscard]] inline bool SendPrompt(const PromptSink* a_sink, const ClientID a_clientID) {
+        return ProcessSendPrompt(a_sink, a_clientID);
+    }
+
+    inline void RemovePrompt(const PromptSink* a_sink, const ClientID a_clientID) {
+        ProcessRemovePrompt(a_sink, a_clientID);
+    }
+
+    [[nodiscard]] inline ClientID RequestClientID() { return ProcessRequestClientID(MAJOR, MINOR); }
+
+    [[nodiscard]] inline bool RequestTheme(const ClientID a_clientID, const std::string_view a_theme) {
+        return ProcessRequestTheme(a_clientID, a_theme);
+    }
+}
@@ -0,0 +1,250 @@
+#pragma once
+// Small stand-in for ankerl::unordered_dense with the same storage model: entries live contiguously in a vector,
+// buckets are an open-addressed index into it and erase moves the last entry into the hole. Iterators are vector
+// iterators, so they are invalidated by insert and erase just like the real map's.
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ankerl::unordered_dense {
+    template <class T>
+    struct hash {
+        using is_avalanching = void;
+
+        [[nodiscard]] std::uint64_t operator()(const T& a_value) const noexcept {
+            auto h = static_cast<std::uint64_t>(std::hash<T>{}(a_value));
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+    };
+
+    template <class Key, class T, class Hash = hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class map {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using size_type = std::size_t;
+        using iterator = typename std::vector<value_type>::iterator;
+        using const_iterator = typename std::vector<value_type>::const_iterator;
+
+        map() = default;
+
+        map(const std::initializer_list<value_type> a_values) {
+            for (const auto& a_value : a_values) {
+                insert(a_value);
+            }
+        }
+
+        iterator begin() { return values_.begin(); }
+        iterator end() { return values_.end(); }
+        const_iterator begin() const { return values_.begin(); }
+        const_iterator end() const { return values_.end(); }
+
+        [[nodiscard]] size_type size() const { return values_.size(); }
+        [[nodiscard]] bool empty() const { return values_.empty(); }
+
+        void clear() {
+            values_.clear();
+            std::fill(buckets_.begin(), buckets_.end(), empty_bucket);
+        }
+
+        void reserve(const size_type a_count) {
+            values_.reserve(a_count);
+            if (a_count * 2 > buckets_.size()) {
+                Rehash(a_count * 2);
+            }
+        }
+
+        template <class K>
+        iterator find(const K& a_key) {
+            const auto slot = FindSlot(a_key);
+            return slot == npos ? values_.end() : values_.begin() + buckets_[slot];
+        }
+
+        template <class K>
+        const_iterator find(const K& a_key) const {
+            const auto slot = FindSlot(a_key);
+            return slot == npos ? values_.end() : values_.begin() + buckets_[slot];
+        }
+
+        template <class K>
+        [[nodiscard]] bool contains(const K& a_key) const { return FindSlot(a_key) != npos; }
+
+        template <class K>
+        [[nodiscard]] size_type count(const K& a_key) const { return contains(a_key) ? 1 : 0; }
+
+        template <class K>
+        T& at(const K& a_key) {
+            const auto it = find(a_key);
+            if (it == end()) {
+                throw std::out_of_range("ankerl::unordered_dense::map::at");
+            }
+            return it->second;
+        }
+
+        template <class K>
+        const T& at(const K& a_key) const {
+            const auto it = find(a_key);
+            if (it == end()) {
+                throw std::out_of_range("ankerl::unordered_dense::map::at");
+            }
+            return it->second;
+        }
+
+        T& operator[](const Key& a_key) { return try_emplace(a_key).first->second; }
+
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(const Key& a_key, Args&&... a_args) {
+            if (const auto it = find(a_key); it != end()) {
+                return {it, false};
+            }
+            values_.emplace_back(std::piecewise_construct, std::forward_as_tuple(a_key),
+                                 std::forward_as_tuple(std::forward<Args>(a_args)...));
+            Index(values_.size() - 1);
+            return {values_.end() - 1, true};
+        }
+
+        template <class K, class V>
+        std::pair<iterator, bool> emplace(K&& a_key, V&& a_value) {
+            if (const auto it = find(a_key); it != end()) {
+                return {it, false};
+            }
+            values_.emplace_back(std::forward<K>(a_key), std::forward<V>(a_value));
+            Index(values_.size() - 1);
+            return {values_.end() - 1, true};
+        }
+
+        std::pair<iterator, bool> insert(const value_type& a_value) { return emplace(a_value.first, a_value.second); }
+
+        size_type erase(const Key& a_key) {
+            const auto slot = FindSlot(a_key);
+            if (slot == npos) {
+                return 0;
+            }
+            EraseSlot(slot);
+            return 1;
+        }
+
+        // like the real map, the last entry moves into the erased one's place
+        iterator erase(const_iterator a_it) {
+            const auto index = static_cast<std::uint32_t>(a_it - values_.cbegin());
+            EraseSlot(FindSlot(values_[index].first));
+            return values_.begin() + index;
+        }
+
+        iterator erase(const iterator a_it) { return erase(const_iterator(a_it)); }
+
+    private:
+        static constexpr std::uint32_t empty_bucket = UINT32_MAX;
+        static constexpr size_t npos = SIZE_MAX;
+
+        std::vector<value_type> values_;
+        std::vector<std::uint32_t> buckets_;
+
+        template <class K>
+        [[nodiscard]] size_t FindSlot(const K& a_key) const {
+            if (buckets_.empty()) {
+                return npos;
+            }
+            const auto mask = buckets_.size() - 1;
+            for (auto i = static_cast<size_t>(Hash{}(a_key)) & mask;; i = (i + 1) & mask) {
+                if (buckets_[i] == empty_bucket) {
+                    return npos;
+                }
+                if (KeyEqual{}(values_[buckets_[i]].first, a_key)) {
+                    return i;
+                }
+            }
+        }
+
+        void Place(const std::uint32_t a_index) {
+            const auto mask = buckets_.size() - 1;
+            auto i = static_cast<size_t>(Hash{}(values_[a_index].first)) & mask;
+            while (buckets_[i] != empty_bucket) {
+                i = (i + 1) & mask;
+            }
+            buckets_[i] = a_index;
+        }
+
+        void Rehash(const size_t a_min_buckets) {
+            size_t n = 8;
+            while (n < a_min_buckets) {
+                n *= 2;
+            }
+            buckets_.assign(n, empty_bucket);
+            for (std::uint32_t i = 0; i < values_.size(); ++i) {
+                Place(i);
+            }
+        }
+
+        void Index(const size_t a_index) {
+            if (values_.size() * 2 > buckets_.size()) {
+                Rehash(values_.size() * 2);
+            } else {
+                Place(static_cast<std::uint32_t>(a_index));
+            }
+        }
+
+        void EraseSlot(size_t a_slot) {
+            const auto mask = buckets_.size() - 1;
+            const auto index = buckets_[a_slot];
+            // backward-shift deletion keeps every probe sequence unbroken
+            for (auto next = (a_slot + 1) & mask; buckets_[next] != empty_bucket; next = (next + 1) & mask) {
+                const auto home = static_cast<size_t>(Hash{}(values_[buckets_[next]].first)) & mask;
+                if (((next - home) & mask) >= ((next - a_slot) & mask)) {
+                    buckets_[a_slot] = buckets_[next];
+                    a_slot = next;
+                }
+            }
+            buckets_[a_slot] = empty_bucket;
+
+            const auto last = static_cast<std::uint32_t>(values_.size() - 1);
+            if (index != last) {
+                auto slot = FindSlot(values_[last].first);
+                buckets_[slot] = index;
+                values_[index] = std::move(values_[last]);
+            }
+            values_.pop_back();
+        }
+    };
+
+    template <class Key, class Hash = hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class set {
+        map<Key, bool, Hash, KeyEqual> map_;
+
+    public:
+        bool insert(const Key& a_key) { return map_.emplace(a_key, true).second; }
+        template <class K>
+        [[nodiscard]] bool contains(const K& a_key) const { return map_.contains(a_key); }
+        template <class K>
+        size_t erase(const K& a_key) { return map_.erase(a_key); }
+        [[nodiscard]] size_t size() const { return map_.size(); }
+        [[nodiscard]] bool empty() const { return map_.empty(); }
+        void clear() { map_.clear(); }
+    };
+}
+
+namespace std {
+    template <class Key, class T, class Hash, class KeyEqual, class Pred>
+    size_t erase_if(ankerl::unordered_dense::map<Key, T, Hash, KeyEqual>& a_map, Pred a_pred) {
+        const auto before = a_map.size();
+        for (auto it = a_map.begin(); it != a_map.end();) {
+            if (a_pred(*it)) {
+                it = a_map.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        return before - a_map.size();
+    }
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// Themes are not loaded from disk in the headless build, so field reflection has nothing to visit.
+namespace boost::pfr {
+    template <class T, class F>
+    void for_each_field(T&&, F&&) {}
+}
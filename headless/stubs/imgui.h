@@ -0,0 +1,59 @@
+#pragma once
+// The ImGui surface the prompt core calls. Windows and draw calls are no-ops; geometry types behave like ImGui's.
+
+struct ImVec2 {
+    float x = 0.f;
+    float y = 0.f;
+
+    constexpr ImVec2() = default;
+    constexpr ImVec2(const float a_x, const float a_y) : x(a_x), y(a_y) {}
+};
+
+struct ImVec4 {
+    float x = 0.f;
+    float y = 0.f;
+    float z = 0.f;
+    float w = 0.f;
+
+    constexpr ImVec4() = default;
+    constexpr ImVec4(const float a_x, const float a_y, const float a_z, const float a_w)
+        : x(a_x), y(a_y), z(a_z), w(a_w) {}
+};
+
+constexpr ImVec2 operator+(const ImVec2& a_lhs, const ImVec2& a_rhs) { return {a_lhs.x + a_rhs.x, a_lhs.y + a_rhs.y}; }
+constexpr ImVec2 operator-(const ImVec2& a_lhs, const ImVec2& a_rhs) { return {a_lhs.x - a_rhs.x, a_lhs.y - a_rhs.y}; }
+constexpr ImVec2 operator*(const ImVec2& a_lhs, const float a_rhs) { return {a_lhs.x * a_rhs, a_lhs.y * a_rhs}; }
+
+constexpr ImVec2& operator+=(ImVec2& a_lhs, const ImVec2& a_rhs) {
+    a_lhs.x += a_rhs.x;
+    a_lhs.y += a_rhs.y;
+    return a_lhs;
+}
+
+constexpr ImVec2& operator-=(ImVec2& a_lhs, const ImVec2& a_rhs) {
+    a_lhs.x -= a_rhs.x;
+    a_lhs.y -= a_rhs.y;
+    return a_lhs;
+}
+
+struct ImFont;
+
+using ImGuiCond = int;
+
+enum ImGuiCond_ {
+    ImGuiCond_None = 0,
+    ImGuiCond_Always = 1 << 0
+};
+
+struct ImGuiIO {
+    ImVec2 DisplaySize{1920.f, 1080.f};
+};
+
+namespace ImGui {
+    inline ImGuiIO& GetIO() {
+        static ImGuiIO io;
+        return io;
+    }
+
+    inline void SetNextWindowPos(const ImVec2&, ImGuiCond = 0, const ImVec2& = ImVec2()) {}
+}
@@ -0,0 +1,11 @@
+#pragma once
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#else
+    #include <chrono>
+    #include <cstdint>
+
+inline std::uint64_t __rdtsc() {
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+#endif
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace rapidjson {
+    class Value {};
+
+    class Document : public Value {};
+}
@@ -0,0 +1,29 @@
+#pragma once
+// Win32 and Direct3D names that appear in the plugin's headers; none of them are used by the headless core.
+#include <cstdint>
+
+using UINT = unsigned int;
+using WPARAM = std::uintptr_t;
+using LPARAM = std::intptr_t;
+using LRESULT = std::intptr_t;
+using HWND = struct HWND__*;
+using WNDPROC = LRESULT (*)(HWND, UINT, WPARAM, LPARAM);
+
+struct IDXGISwapChain;
+struct ID3D11Device;
+struct ID3D11DeviceContext;
+struct ID3D11ShaderResourceView;
+
+namespace Microsoft::WRL {
+    template <class T>
+    class ComPtr {
+    public:
+        ComPtr() = default;
+        ComPtr(std::nullptr_t) {}
+
+        [[nodiscard]] T* Get() const { return ptr_; }
+
+    private:
+        T* ptr_ = nullptr;
+    };
+}
@@ -0,0 +1,127 @@
+#include "Counters.h"
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <pthread.h>
+
+namespace {
+    thread_local uint64_t allocations = 0;
+    thread_local uint64_t locks = 0;
+    thread_local uint64_t contended = 0;
+    thread_local uint64_t wait_ns = 0;
+
+    uint64_t MonotonicNs() {
+        timespec ts{};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    // a_try first; only when that fails is the lock contended and the blocking a_lock timed
+    template <class Lock, class Try, class Block>
+    int Acquire(Lock* a_lock, Try a_try, Block a_block) {
+        ++locks;
+        if (a_try(a_lock) == 0) {
+            return 0;
+        }
+        ++contended;
+        const auto start = MonotonicNs();
+        const int result = a_block(a_lock);
+        wait_ns += MonotonicNs() - start;
+        return result;
+    }
+
+    void* Allocate(const std::size_t a_size) {
+        ++allocations;
+        return std::malloc(a_size ? a_size : 1);
+    }
+
+    void* AllocateAligned(const std::size_t a_size, const std::align_val_t a_align) {
+        ++allocations;
+        const auto align = static_cast<std::size_t>(a_align);
+        return std::aligned_alloc(align, (a_size + align - 1) / align * align);
+    }
+}
+
+Counters::Snapshot Counters::Now() {
+    return {allocations, locks, contended, wait_ns};
+}
+
+extern "C" {
+    int __real_pthread_mutex_lock(pthread_mutex_t* a_mutex);
+    int __real_pthread_rwlock_rdlock(pthread_rwlock_t* a_lock);
+    int __real_pthread_rwlock_wrlock(pthread_rwlock_t* a_lock);
+
+    int __wrap_pthread_mutex_lock(pthread_mutex_t* a_mutex) {
+        return Acquire(a_mutex, pthread_mutex_trylock, __real_pthread_mutex_lock);
+    }
+
+    int __wrap_pthread_rwlock_rdlock(pthread_rwlock_t* a_lock) {
+        return Acquire(a_lock, pthread_rwlock_tryrdlock, __real_pthread_rwlock_rdlock);
+    }
+
+    int __wrap_pthread_rwlock_wrlock(pthread_rwlock_t* a_lock) {
+        return Acquire(a_lock, pthread_rwlock_trywrlock, __real_pthread_rwlock_wrlock);
+    }
+}
+
+void* operator new(const std::size_t a_size) {
+    if (const auto ptr = Allocate(a_size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t a_size) {
+    return operator new(a_size);
+}
+
+void* operator new(const std::size_t a_size, const std::nothrow_t&) noexcept {
+    return Allocate(a_size);
+}
+
+void* operator new[](const std::size_t a_size, const std::nothrow_t&) noexcept {
+    return Allocate(a_size);
+}
+
+void* operator new(const std::size_t a_size, const std::align_val_t a_align) {
+    if (const auto ptr = AllocateAligned(a_size, a_align)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t a_size, const std::align_val_t a_align) {
+    return operator new(a_size, a_align);
+}
+
+void operator delete(void* a_ptr) noexcept {
+    std::free(a_ptr);
+}
+
+void operator delete[](void* a_ptr) noexcept {
+    std::free(a_ptr);
+}
+
+void operator delete(void* a_ptr, std::size_t) noexcept {
+    std::free(a_ptr);
+}
+
+void operator delete[](void* a_ptr, std::size_t) noexcept {
+    std::free(a_ptr);
+}
+
+void operator delete(void* a_ptr, std::align_val_t) noexcept {
+    std::free(a_ptr);
+}
+
+void operator delete[](void* a_ptr, std::align_val_t) noexcept {
+    std::free(a_ptr);
+}
+
+void operator delete(void* a_ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(a_ptr);
+}
+
+void operator delete[](void* a_ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(a_ptr);
+}
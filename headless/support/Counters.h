@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+
+// Heap allocations and lock acquisitions made by the calling thread. Allocations are counted by replacing the global
+// operator new, locks by wrapping pthread's lock calls at link time (see headless/CMakeLists.txt), which covers
+// std::mutex, std::recursive_mutex and both sides of std::shared_mutex. A lock is contended when it could not be
+// taken straight away; wait_ns is the time spent blocked on those.
+namespace Counters {
+    struct Snapshot {
+        uint64_t allocations = 0;
+        uint64_t locks = 0;
+        uint64_t contended = 0;
+        uint64_t wait_ns = 0;
+
+        Snapshot operator-(const Snapshot& a_rhs) const {
+            return {allocations - a_rhs.allocations, locks - a_rhs.locks, contended - a_rhs.contended,
+                    wait_ns - a_rhs.wait_ns};
+        }
+    };
+
+    [[nodiscard]] Snapshot Now();
+}
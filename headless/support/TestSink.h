@@ -0,0 +1,71 @@
+#pragma once
+#include "SkyPrompt/API.hpp"
+
+// A sink that owns its prompts and records every event it is sent, for tests and benchmarks.
+class TestSink final : public SkyPromptAPI::PromptSink {
+public:
+    struct Spec {
+        std::string text;
+        SkyPromptAPI::EventID event = 0;
+        SkyPromptAPI::ActionID action = 0;
+        SkyPromptAPI::PromptType type = SkyPromptAPI::kSinglePress;
+        RefID refid = 0;
+        std::vector<std::pair<RE::INPUT_DEVICE, SkyPromptAPI::ButtonID>> keys = {};
+        float progress = 0.f;
+    };
+
+    TestSink() = default;
+
+    explicit TestSink(std::vector<Spec> a_specs) : specs_(std::move(a_specs)) { Rebuild(); }
+
+    TestSink(const TestSink&) = delete;
+    TestSink& operator=(const TestSink&) = delete;
+
+    void Add(Spec a_spec) {
+        specs_.push_back(std::move(a_spec));
+        Rebuild();
+    }
+
+    void SetText(const size_t a_index, std::string a_text) {
+        specs_.at(a_index).text = std::move(a_text);
+        prompts_[a_index].text = specs_[a_index].text;
+    }
+
+    void SetProgress(const size_t a_index, const float a_progress) {
+        specs_.at(a_index).progress = a_progress;
+        prompts_[a_index].progress = a_progress;
+    }
+
+    [[nodiscard]] std::span<const SkyPromptAPI::Prompt> GetPrompts() const override { return prompts_; }
+
+    void ProcessEvent(const SkyPromptAPI::PromptEvent a_event) const override {
+        events_.push_back(a_event);
+        if (on_event) {
+            on_event(a_event);
+        }
+    }
+
+    [[nodiscard]] const std::vector<SkyPromptAPI::PromptEvent>& Events() const { return events_; }
+
+    [[nodiscard]] size_t Count(const SkyPromptAPI::PromptEventType a_type) const {
+        return static_cast<size_t>(std::ranges::count(events_, a_type, &SkyPromptAPI::PromptEvent::type));
+    }
+
+    void ClearEvents() const { events_.clear(); }
+
+    // also called for every event, after it was recorded
+    std::function<void(const SkyPromptAPI::PromptEvent&)> on_event;
+
+private:
+    std::vector<Spec> specs_;
+    std::vector<SkyPromptAPI::Prompt> prompts_;
+    mutable std::vector<SkyPromptAPI::PromptEvent> events_;
+
+    void Rebuild() {
+        prompts_.clear();
+        for (const auto& a_spec : specs_) {
+            prompts_.emplace_back(a_spec.text, a_spec.event, a_spec.action, a_spec.type, a_spec.refid, a_spec.keys,
+                                  0xFFFFFFFF, a_spec.progress);
+        }
+    }
+};
@@ -0,0 +1,87 @@
+#pragma once
+#include "Trace.h"
+
+// Reads back what Trace::Manager wrote, one record at a time. Only the fields of the record's kind are filled in.
+namespace Trace {
+    struct SentPrompt {
+        PromptRecord record{};
+        std::string text;
+        std::vector<KeyRecord> keys;
+    };
+
+    struct Record {
+        RecordHeader header{};
+        FrameRecord frame{};
+        ButtonRecord button{};
+        MouseMoveRecord mouse_move{};
+        ThumbstickRecord thumbstick{};
+        SendRecord send{};
+        std::vector<SentPrompt> prompts;
+        RemoveRecord remove{};
+    };
+
+    class Reader {
+    public:
+        explicit Reader(const std::filesystem::path& a_path) : file_(a_path, std::ios::binary) {
+            FileHeader header{};
+            valid_ = Read(header) && header.magic == magic && header.version == version;
+        }
+
+        // false if the file could not be opened or is not a trace of this version
+        [[nodiscard]] bool IsValid() const { return valid_; }
+
+        // false at the end of the file, or at a record that was cut short or is of an unknown kind
+        bool Next(Record& a_record) {
+            if (!valid_ || !Read(a_record.header)) {
+                return false;
+            }
+            switch (a_record.header.kind) {
+                case Kind::kFrame:
+                    return Read(a_record.frame);
+                case Kind::kButton:
+                    return Read(a_record.button);
+                case Kind::kMouseMove:
+                    return Read(a_record.mouse_move);
+                case Kind::kThumbstick:
+                    return Read(a_record.thumbstick);
+                case Kind::kSend:
+                    return ReadPrompts(a_record);
+                case Kind::kRemove:
+                    return Read(a_record.remove);
+            }
+            return false;
+        }
+
+    private:
+        std::ifstream file_;
+        bool valid_ = false;
+
+        template <class T>
+        bool Read(T& a_value) {
+            return static_cast<bool>(file_.read(reinterpret_cast<char*>(&a_value), sizeof(T)));
+        }
+
+        bool ReadPrompts(Record& a_record) {
+            if (!Read(a_record.send)) {
+                return false;
+            }
+            a_record.prompts.resize(a_record.send.prompt_count);
+            for (auto& [record, text, keys] : a_record.prompts) {
+                if (!Read(record)) {
+                    return false;
+                }
+                text.resize(record.text_length);
+                if (!file_.read(text.data(), record.text_length)) {
+                    return false;
+                }
+                keys.resize(record.key_count);
+                for (auto& a_key : keys) {
+                    if (!Read(a_key)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    };
+}
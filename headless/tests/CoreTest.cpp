@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "Headless.h"
+#include "TestSink.h"
+
+using namespace SkyPromptAPI;
+
+namespace {
+    class CoreTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            Headless::Init();
+            Headless::ResetDraws();
+            client = RequestClientID();
+            ASSERT_NE(client, 0);
+        }
+
+        static void Frames(const int a_count) {
+            for (int i = 0; i < a_count; ++i) {
+                Headless::Tick();
+            }
+        }
+
+        ClientID client = 0;
+    };
+}
+
+TEST_F(CoreTest, SentPromptIsDrawn) {
+    TestSink sink({{.text = "Open", .event = 1, .action = 1}});
+    ASSERT_TRUE(SendPrompt(&sink, client));
+    Headless::RecordTexts(true);
+    Frames(1);
+    ASSERT_EQ(Headless::Draws().batches, 1u);
+    ASSERT_EQ(Headless::Draws().last_texts.size(), 1u);
+    EXPECT_EQ(Headless::Draws().last_texts[0], "Open");
+}
+
+TEST_F(CoreTest, RemovedPromptStopsBeingDrawn) {
+    TestSink sink({{.text = "Open", .event = 1, .action = 1}});
+    ASSERT_TRUE(SendPrompt(&sink, client));
+    Frames(2);
+    RemovePrompt(&sink, client);
+    Frames(2);
+    Headless::ResetDraws();
+    Frames(10);
+    EXPECT_EQ(Headless::Draws().prompts, 0u);
+    EXPECT_EQ(sink.Count(kTimeout), 0u);
+}
+
+TEST_F(CoreTest, UnattendedPromptTimesOut) {
+    MCP::Settings::lifetime = 1.f;
+    TestSink sink({{.text = "Open", .event = 1, .action = 1}});
+    ASSERT_TRUE(SendPrompt(&sink, client));
+    // one second of frames plus the fade-out
+    Frames(240);
+    EXPECT_EQ(sink.Count(kTimeout), 1u);
+    EXPECT_FALSE(MANAGER(ImGui::Renderer)->IsInQueue(client, &sink));
+}
+
+TEST_F(CoreTest, EachFadeOutSendsOneTimingOutPerPrompt) {
+    MCP::Settings::lifetime = 1.f;
+    // two slots, one of them with two prompts queued
+    TestSink sink({{.text = "Open", .event = 1, .action = 1},
+                   {.text = "Take", .event = 1, .action = 2},
+                   {.text = "Close", .event = 2, .action = 3}});
+    for (size_t fade_outs = 1; fade_outs <= 2; ++fade_outs) {
+        ASSERT_TRUE(SendPrompt(&sink, client));
+        int fading_frames = 0;
+        for (int frame = 0; frame < 1000 && sink.Count(kTimeout) < 3 * fade_outs; ++frame) {
+            Headless::Tick();
+            fading_frames += sink.Count(kTimingOut) == 3 * fade_outs;
+        }
+        ASSERT_EQ(sink.Count(kTimeout), 3 * fade_outs);
+        // the fade-out took frames, and none of them after the first sent it again
+        EXPECT_GT(fading_frames, 1);
+        EXPECT_EQ(sink.Count(kTimingOut), 3 * fade_outs);
+    }
+    for (const auto action : {1u, 2u, 3u}) {
+        EXPECT_EQ(std::ranges::count_if(sink.Events(), [action](const PromptEvent& a_event) {
+            return a_event.type == kTimingOut && a_event.prompt.actionID == action;
+        }), 2) << "action " << action;
+    }
+}
+
+TEST_F(CoreTest, EveryPromptWithTheSameActionGetsTheEvent) {
+    MCP::Settings::lifetime = 1.f;
+    TestSink sink({{.text = "Open", .event = 1, .action = 1},
+                   {.text = "Close", .event = 2, .action = 1},
+                   {.text = "Open again", .event = 1, .action = 1}});
+    // the text only lives as long as the queued copy, so keep it while it is delivered
+    std::vector<std::string> timed_out;
+    sink.on_event = [&timed_out](const PromptEvent& a_event) {
+        if (a_event.type == kTimeout) {
+            timed_out.emplace_back(a_event.prompt.text);
+        }
+    };
+    ASSERT_TRUE(SendPrompt(&sink, client));
+    Frames(240);
+    std::ranges::sort(timed_out);
+    EXPECT_EQ(timed_out, (std::vector<std::string>{"Close", "Open", "Open again"}));
+}
+
+TEST_F(CoreTest, IdleFramesSkipRenderPrompts) {
+    Frames(5);
+    EXPECT_FALSE(Headless::Tick());
+    TestSink sink({{.text = "Open", .event = 1, .action = 1}});
+    ASSERT_TRUE(SendPrompt(&sink, client));
+    EXPECT_TRUE(Headless::Tick());
+}
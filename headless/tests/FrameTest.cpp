@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "Counters.h"
+#include "Headless.h"
+#include "TestSink.h"
+
+using namespace SkyPromptAPI;
+
+// What a frame costs once the prompts on screen stop changing.
+
+namespace {
+    class FrameTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            Headless::Init();
+            MCP::Settings::lifetime = 1e6f;
+            client = RequestClientID();
+            ASSERT_NE(client, 0);
+        }
+
+        static void Frames(const int a_count) {
+            for (int i = 0; i < a_count; ++i) {
+                Headless::Tick();
+            }
+        }
+
+        ClientID client = 0;
+    };
+}
+
+TEST_F(FrameTest, SteadyFramesDoNotAllocate) {
+    std::vector<std::unique_ptr<TestSink>> sinks;
+    for (int i = 0; i < 24; ++i) {
+        // three prompts per slot, so queues have something to cycle through
+        sinks.push_back(std::make_unique<TestSink>(std::vector<TestSink::Spec>{
+            {.text = std::format("Prompt {}", i), .event = static_cast<EventID>(i % 8 + 1),
+             .action = static_cast<ActionID>(i + 1), .type = i % 2 ? kHold : kSinglePress}}));
+        ASSERT_TRUE(SendPrompt(sinks.back().get(), client));
+    }
+    Frames(10);
+    ASSERT_GT(Headless::Draws().prompts, 0u);
+
+    const auto before = Counters::Now();
+    Frames(500);
+    EXPECT_EQ((Counters::Now() - before).allocations, 0u);
+}
+
+TEST(FrameDemandTest, IdleOnlyWhenNothingApplies) {
+    EXPECT_TRUE(ImGui::Renderer::FrameDemand{}.Idle());
+    for (const auto field : {&ImGui::Renderer::FrameDemand::has_prompts,
+                             &ImGui::Renderer::FrameDemand::pending_submissions,
+                             &ImGui::Renderer::FrameDemand::pending_inputs,
+                             &ImGui::Renderer::FrameDemand::pending_events,
+                             &ImGui::Renderer::FrameDemand::deferred_due,
+                             &ImGui::Renderer::FrameDemand::reload_lifetime,
+                             &ImGui::Renderer::FrameDemand::reload_prompt_size}) {
+        ImGui::Renderer::FrameDemand demand;
+        demand.*field = true;
+        EXPECT_FALSE(demand.Idle());
+    }
+}
+
+TEST_F(FrameTest, FramesRunUntilTheLastPromptHasFadedOut) {
+    MCP::Settings::lifetime = 1.f;
+    TestSink sink({{.text = "Open", .event = 1, .action = 1}});
+    ASSERT_TRUE(SendPrompt(&sink, client));
+
+    // every frame runs through the lifetime and the whole fade-out, up to and including the one sending kTimeout
+    int frames = 0;
+    while (sink.Count(kTimeout) == 0 && frames < 1000) {
+        ASSERT_TRUE(Headless::Tick()) << "frame " << frames;
+        ++frames;
+    }
+    ASSERT_EQ(sink.Count(kTimeout), 1u);
+    EXPECT_GT(frames, 60);
+
+    const auto before = Counters::Now();
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_FALSE(Headless::Tick());
+    }
+    EXPECT_EQ((Counters::Now() - before).allocations, 0u);
+}
+
+TEST_F(FrameTest, DueDeferredWorkWakesAnIdleFrame) {
+    Frames(2);
+    ASSERT_FALSE(Headless::Tick());
+    bool ran = false;
+    {
+        const auto frame = MANAGER(ImGui::Renderer)->LockFrame();
+        MANAGER(ImGui::Renderer)->Defer(std::chrono::milliseconds(0), [&ran] { ran = true; });
+    }
+    EXPECT_TRUE(Headless::Tick());
+    EXPECT_TRUE(ran);
+    EXPECT_FALSE(Headless::Tick());
+}
+
+TEST_F(FrameTest, DeferredWorkRunsByDeadlineAndWhatItDefersWaitsAFrame) {
+    const auto manager = MANAGER(ImGui::Renderer);
+    std::vector<std::string> ran;
+    {
+        const auto frame = manager->LockFrame();
+        manager->Defer(std::chrono::milliseconds(0), [&ran, manager] {
+            ran.emplace_back("first");
+            // already overdue, but deferred while running: the next frame's, and not in the way of what is due now
+            manager->Defer(std::chrono::milliseconds(-50), [&ran] { ran.emplace_back("deferred by first"); });
+        });
+        manager->Defer(std::chrono::milliseconds(0), [&ran] { ran.emplace_back("second"); });
+        manager->Defer(std::chrono::milliseconds(-10), [&ran] { ran.emplace_back("earliest"); });
+        manager->Defer(std::chrono::hours(1), [&ran] { ran.emplace_back("later"); });
+    }
+    Headless::Tick();
+    EXPECT_EQ(ran, (std::vector<std::string>{"earliest", "first", "second"}));
+    Headless::Tick();
+    EXPECT_EQ(ran, (std::vector<std::string>{"earliest", "first", "second", "deferred by first"}));
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "ClientSet.h"
+#include "IndexedHeap.h"
+#include "MPSCQueue.h"
+#include "TimerWheel.h"
+
+// The self-contained containers the queue is built on, checked against the obvious std equivalent.
+
+TEST(ClientSetTest, MatchesStdSet) {
+    ClientSet set;
+    std::set<SkyPromptAPI::ClientID> expected;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> id(0, 65535);
+    for (int i = 0; i < 2000; ++i) {
+        const auto a_id = static_cast<SkyPromptAPI::ClientID>(i % 3 ? id(rng) : id(rng) % 300);
+        const bool add = rng() % 4 != 0;
+        set.Set(a_id, add);
+        add ? (void)expected.insert(a_id) : (void)expected.erase(a_id);
+    }
+    ASSERT_EQ(set.Count(), expected.size());
+
+    for (int i = 0; i < 2000; ++i) {
+        const auto a_id = static_cast<SkyPromptAPI::ClientID>(id(rng));
+        EXPECT_EQ(set.Test(a_id), expected.contains(a_id));
+        EXPECT_EQ(set.Rank(a_id), static_cast<size_t>(std::distance(expected.begin(), expected.lower_bound(a_id))));
+
+        const auto first = expected.lower_bound(a_id);
+        EXPECT_EQ(set.First(a_id), first == expected.end() ? std::nullopt : std::optional(*first));
+        const auto last = expected.upper_bound(a_id);
+        EXPECT_EQ(set.Last(a_id), last == expected.begin() ? std::nullopt : std::optional(*std::prev(last)));
+    }
+}
+
+TEST(ClientSetTest, NeighbourWrapsAndSkipsItself) {
+    ClientSet set;
+    set.Set(3, true);
+    EXPECT_EQ(set.Neighbour(3, false), std::nullopt);
+    set.Set(65535, true);
+    set.Set(70, true);
+    EXPECT_EQ(set.Neighbour(3, false), 70);
+    EXPECT_EQ(set.Neighbour(65535, false), 3);
+    EXPECT_EQ(set.Neighbour(3, true), 65535);
+    EXPECT_EQ(set.Neighbour(70, true), 3);
+
+    const auto version = set.Version();
+    set.Set(70, true);
+    EXPECT_EQ(set.Version(), version);
+    set.Set(70, false);
+    EXPECT_NE(set.Version(), version);
+}
+
+TEST(TimerWheelTest, FiresAtTheScheduledTick) {
+    TimerWheel<uint64_t> wheel;
+    std::mt19937 rng(11);
+    std::multiset<uint64_t> pending;
+    // spans all three levels and past the wheel's reach
+    for (int i = 0; i < 3000; ++i) {
+        const uint64_t tick = rng() % 400'000 + 1;
+        wheel.Schedule(tick, tick);
+        pending.insert(tick);
+    }
+    uint64_t now = 0;
+    while (!wheel.Empty()) {
+        now += rng() % 200 + 1;
+        wheel.Advance(now, [&](const uint64_t a_tick) {
+            EXPECT_EQ(a_tick, wheel.Now());
+            EXPECT_LE(a_tick, now);
+            pending.erase(pending.find(a_tick));
+        });
+        EXPECT_TRUE(pending.empty() || *pending.begin() > now);
+    }
+    EXPECT_TRUE(pending.empty());
+}
+
+TEST(TimerWheelTest, PastTicksFireOnTheNextAdvance) {
+    TimerWheel<int> wheel;
+    wheel.Advance(100, [](int) {});
+    wheel.Schedule(1, 50);
+    std::vector<int> fired;
+    wheel.Advance(101, [&](const int a_value) { fired.push_back(a_value); });
+    EXPECT_EQ(fired, std::vector{1});
+}
+
+TEST(IndexedHeapTest, PopsByScoreThenInsertionOrder) {
+    IndexedHeap<int, double> heap;
+    std::mt19937 rng(3);
+    std::vector<std::tuple<double, int, int>> expected; // -score, seq, key
+    for (int key = 0; key < 500; ++key) {
+        const double score = rng() % 20;
+        ASSERT_TRUE(heap.Push(key, score));
+        expected.emplace_back(-score, key, key);
+    }
+    EXPECT_FALSE(heap.Push(0, 100.0));
+    for (int key = 0; key < 500; key += 7) {
+        ASSERT_TRUE(heap.Erase(key));
+        std::erase_if(expected, [key](const auto& a_entry) { return std::get<2>(a_entry) == key; });
+    }
+    EXPECT_FALSE(heap.Erase(0));
+    std::ranges::sort(expected);
+    ASSERT_EQ(heap.Size(), expected.size());
+    for (const auto& [score, seq, key] : expected) {
+        EXPECT_EQ(heap.TopScore(), -score);
+        EXPECT_EQ(heap.Pop(), key);
+    }
+    EXPECT_TRUE(heap.Empty());
+}
+
+TEST(MPSCQueueTest, DeliversEveryPushOnceInProducerOrder) {
+    constexpr int producers = 4;
+    constexpr int per_producer = 5000;
+    MPSCQueue<std::pair<int, int>, 256> queue;
+    std::vector<std::jthread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p] {
+            for (int i = 0; i < per_producer;) {
+                if (queue.TryPush({p, i})) {
+                    ++i;
+                }
+            }
+        });
+    }
+    std::array<int, producers> next{};
+    for (int received = 0; received < producers * per_producer;) {
+        if (std::pair<int, int> item; queue.TryPop(item)) {
+            ASSERT_EQ(item.second, next[item.first]++);
+            ++received;
+        }
+    }
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_EQ(queue.Consumed(), size_t{producers * per_producer});
+}
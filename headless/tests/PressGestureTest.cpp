@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "PressGesture.h"
+
+using namespace PressGesture;
+
+// The transition table replayed side by side with the press counting it replaced, which lived in ApplyInput,
+// ButtonStateActions and UpdateProgressCircle; both have to agree on every action and on what the circle shows.
+
+namespace {
+    constexpr auto interval = std::chrono::milliseconds(300);
+
+    // the old code, kept as it was apart from returning the action instead of carrying it out
+    struct Baseline {
+        int pressCount = 0;
+        bool isPressing = false;
+        Clock::time_point lastPressTime{};
+
+        void Button(const bool a_pressed, const bool a_down, const Clock::time_point a_time) {
+            isPressing = a_pressed;
+            if (a_down) {
+                pressCount++;
+                lastPressTime = a_time;
+            }
+        }
+
+        Action ButtonStateActions(const Clock::time_point a_now, const bool a_has_progress) {
+            pressCount = std::min(6, pressCount);
+            if (!a_has_progress) {
+                // the one change: on plain prompts the count never went back to 0, which kept HasPendingActions true
+                if (!isPressing && a_now - lastPressTime > interval) {
+                    pressCount = 0;
+                }
+                return Action::kNone;
+            }
+            if (isPressing) {
+                return Action::kNone;
+            }
+            if (a_now - lastPressTime > interval) {
+                const auto action = pressCount == 2 ? Action::kDecline : pressCount == 3 ? Action::kSkip : Action::kNone;
+                pressCount = 0;
+                return action;
+            }
+            if (pressCount == 4 || pressCount >= 6) {
+                pressCount = 5;
+                return Action::kSkip;
+            }
+            return Action::kNone;
+        }
+
+        void LongRelease() { pressCount = 0; }
+
+        Action HoldComplete(const bool a_has_progress) {
+            if (pressCount == 3 && a_has_progress) {
+                pressCount = 0;
+                return Action::kDeleteAll;
+            }
+            return Action::kAccept;
+        }
+
+        [[nodiscard]] float Display() const {
+            auto count = pressCount;
+            if (isPressing && count < 3) {
+                count--;
+            }
+            return static_cast<float>(count) + 0.1f;
+        }
+    };
+
+    // one recorded input: a button edge or repeat, the per-frame check, or what the progress circle reports
+    struct Step {
+        enum class Kind : std::uint8_t {
+            kDown,
+            kHeld,
+            kUp,
+            kFrame,
+            kLongRelease,
+            kHoldComplete
+        };
+
+        Kind kind;
+        // since the previous step
+        std::chrono::milliseconds delay{0};
+    };
+
+    // replays a_trace through both and returns the actions the machine produced
+    std::vector<Action> Replay(const std::vector<Step>& a_trace, const bool a_has_progress) {
+        Machine machine;
+        Baseline baseline;
+        std::vector<Action> actions;
+        auto now = Clock::time_point{} + std::chrono::seconds(10);
+        for (size_t i = 0; i < a_trace.size(); ++i) {
+            const auto& [kind, delay] = a_trace[i];
+            now += delay;
+            auto action = Action::kNone;
+            auto expected = Action::kNone;
+            switch (kind) {
+                case Step::Kind::kDown:
+                case Step::Kind::kHeld:
+                case Step::Kind::kUp: {
+                    const bool pressed = kind != Step::Kind::kUp;
+                    const bool down = kind == Step::Kind::kDown;
+                    action = machine.Button(pressed, down, now, a_has_progress);
+                    baseline.Button(pressed, down, now);
+                    break;
+                }
+                case Step::Kind::kFrame:
+                    action = machine.Tick(now, interval, a_has_progress);
+                    expected = baseline.ButtonStateActions(now, a_has_progress);
+                    break;
+                case Step::Kind::kLongRelease:
+                    action = machine.Feed(Event::kLongRelease, a_has_progress);
+                    baseline.LongRelease();
+                    break;
+                case Step::Kind::kHoldComplete:
+                    action = machine.Feed(Event::kHoldComplete, a_has_progress) == Action::kDeleteAll
+                                 ? Action::kDeleteAll
+                                 : Action::kAccept;
+                    expected = baseline.HoldComplete(a_has_progress);
+                    break;
+            }
+            EXPECT_EQ(action, expected) << "step " << i;
+            if (kind == Step::Kind::kFrame) {
+                // the old count only settled back to at most 6 once a frame
+                EXPECT_EQ(machine.presses, baseline.pressCount) << "step " << i;
+                EXPECT_EQ(machine.Display(), baseline.Display()) << "step " << i;
+            }
+            if (action != Action::kNone) {
+                actions.push_back(action);
+            }
+        }
+        return actions;
+    }
+
+    std::vector<Step> Presses(const int a_count) {
+        std::vector<Step> trace;
+        for (int i = 0; i < a_count; ++i) {
+            trace.push_back({Step::Kind::kDown, std::chrono::milliseconds(60)});
+            trace.push_back({Step::Kind::kFrame, std::chrono::milliseconds(16)});
+            trace.push_back({Step::Kind::kUp, std::chrono::milliseconds(40)});
+            trace.push_back({Step::Kind::kFrame, std::chrono::milliseconds(16)});
+        }
+        return trace;
+    }
+
+    void Quiet(std::vector<Step>& a_trace) {
+        a_trace.push_back({Step::Kind::kFrame, interval + std::chrono::milliseconds(50)});
+    }
+}
+
+TEST(PressGestureTest, DoublePressDeclines) {
+    auto trace = Presses(2);
+    Quiet(trace);
+    EXPECT_EQ(Replay(trace, true), std::vector{Action::kDecline});
+}
+
+TEST(PressGestureTest, TriplePressSkips) {
+    auto trace = Presses(3);
+    Quiet(trace);
+    EXPECT_EQ(Replay(trace, true), std::vector{Action::kSkip});
+}
+
+TEST(PressGestureTest, TriplePressAndHoldDeletesAll) {
+    auto trace = Presses(2);
+    trace.push_back({Step::Kind::kDown, std::chrono::milliseconds(60)});
+    for (int i = 0; i < 30; ++i) {
+        trace.push_back({Step::Kind::kHeld, std::chrono::milliseconds(16)});
+        trace.push_back({Step::Kind::kFrame});
+    }
+    trace.push_back({Step::Kind::kHoldComplete});
+    trace.push_back({Step::Kind::kUp, std::chrono::milliseconds(16)});
+    trace.push_back({Step::Kind::kLongRelease});
+    Quiet(trace);
+    EXPECT_EQ(Replay(trace, true), std::vector{Action::kDeleteAll});
+}
+
+TEST(PressGestureTest, PressesPastTheThirdSkipStraightAway) {
+    auto trace = Presses(4);
+    EXPECT_EQ(Replay(trace, true), std::vector{Action::kSkip});
+}
+
+TEST(PressGestureTest, PlainPromptsOnlyAccept) {
+    auto trace = Presses(3);
+    trace.push_back({Step::Kind::kHoldComplete});
+    Quiet(trace);
+    EXPECT_EQ(Replay(trace, false), std::vector{Action::kAccept});
+}
+
+TEST(PressGestureTest, PlainPromptsForgetTheBurstOnceQuiet) {
+    auto trace = Presses(2);
+    Quiet(trace);
+    EXPECT_TRUE(Replay(trace, false).empty());
+
+    Machine machine;
+    const auto now = Clock::time_point{} + std::chrono::seconds(10);
+    (void)machine.Button(true, true, now, false);
+    (void)machine.Button(false, false, now + std::chrono::milliseconds(50), false);
+    EXPECT_EQ(machine.Tick(now + std::chrono::milliseconds(100), interval, false), Action::kNone);
+    EXPECT_EQ(machine.presses, 1);
+    EXPECT_EQ(machine.Tick(now + interval + std::chrono::milliseconds(50), interval, false), Action::kNone);
+    EXPECT_EQ(machine.presses, 0);
+}
+
+TEST(PressGestureTest, RandomTracesMatchTheOldCounting) {
+    std::mt19937 rng(11);
+    std::discrete_distribution<int> kind({20, 10, 20, 40, 4, 2});
+    std::uniform_int_distribution<int> delay(0, 400);
+    for (const bool has_progress : {true, false}) {
+        std::vector<Step> trace;
+        for (int i = 0; i < 200'000; ++i) {
+            trace.push_back({static_cast<Step::Kind>(kind(rng)), std::chrono::milliseconds(delay(rng))});
+        }
+        (void)Replay(trace, has_progress);
+        if (HasFailure()) {
+            break;
+        }
+    }
+}
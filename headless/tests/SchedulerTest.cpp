@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include "Headless.h"
+#include "Service.h"
+#include "TestSink.h"
+
+using namespace SkyPromptAPI;
+
+// More prompts than slots: who gets a slot, who waits, and that nobody is left half on screen.
+
+namespace {
+    class SchedulerTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            Headless::Init(2);
+            Headless::ResetDraws();
+            Headless::RecordTexts(true);
+            MCP::Settings::lifetime = 1e6f;
+            client = RequestClientID();
+            ASSERT_NE(client, 0);
+        }
+
+        void TearDown() override { Headless::RecordTexts(false); }
+
+        static void Frames(const int a_count) {
+            for (int i = 0; i < a_count; ++i) {
+                Headless::Tick();
+            }
+        }
+
+        bool Send(const TestSink& a_sink, const int a_priority = 0) const {
+            return ProcessSetPromptPriority(&a_sink, client, a_priority) && SendPrompt(&a_sink, client);
+        }
+
+        bool Shown(const TestSink& a_sink) const { return MANAGER(ImGui::Renderer)->IsInQueue(client, &a_sink); }
+
+        static bool Drawn(const std::string_view a_text) {
+            return std::ranges::find(Headless::Draws().last_texts, a_text) != Headless::Draws().last_texts.end();
+        }
+
+        ClientID client = 0;
+    };
+}
+
+TEST_F(SchedulerTest, PreemptionFreesEverySlotTheSinkNeeds) {
+    TestSink low1({{.text = "Low 1", .event = 1, .action = 1}});
+    TestSink low2({{.text = "Low 2", .event = 2, .action = 1}});
+    TestSink high({{.text = "High 3", .event = 3, .action = 1}, {.text = "High 4", .event = 4, .action = 1}});
+    ASSERT_TRUE(Send(low1));
+    ASSERT_TRUE(Send(low2));
+    Frames(2);
+    ASSERT_TRUE(Shown(low1) && Shown(low2));
+
+    // both slots have to go, not the same one twice
+    ASSERT_TRUE(Send(high, 5));
+    Frames(2);
+    EXPECT_TRUE(Drawn("High 3"));
+    EXPECT_TRUE(Drawn("High 4"));
+    EXPECT_FALSE(Shown(low1));
+    EXPECT_FALSE(Shown(low2));
+
+    RemovePrompt(&high, client);
+    Frames(3);
+    EXPECT_TRUE(Shown(low1));
+    EXPECT_TRUE(Shown(low2));
+    EXPECT_EQ(low1.Count(kTimeout) + low2.Count(kTimeout), 0u);
+}
+
+TEST_F(SchedulerTest, SinkWaitsWholeWhenThereIsNotRoomForAllOfIt) {
+    TestSink low({{.text = "Low", .event = 1, .action = 1}});
+    TestSink top({{.text = "Top", .event = 2, .action = 1}});
+    TestSink high({{.text = "High 3", .event = 3, .action = 1}, {.text = "High 4", .event = 4, .action = 1}});
+    ASSERT_TRUE(Send(low));
+    ASSERT_TRUE(Send(top, 10));
+    Frames(2);
+
+    // it could push out low, but needs two slots and top does not give way
+    ASSERT_TRUE(Send(high, 5));
+    Frames(2);
+    EXPECT_FALSE(Shown(high));
+    EXPECT_TRUE(Shown(low));
+    EXPECT_TRUE(Shown(top));
+
+    RemovePrompt(&top, client);
+    Frames(3);
+    EXPECT_TRUE(Drawn("High 3"));
+    EXPECT_TRUE(Drawn("High 4"));
+    EXPECT_FALSE(Shown(low));
+}
+
+TEST_F(SchedulerTest, ContendedSlotsServeEverySinkInTurn) {
+    MCP::Settings::lifetime = 0.5f;
+    constexpr int n_sinks = 12;
+    std::vector<std::unique_ptr<TestSink>> sinks;
+    for (int i = 0; i < n_sinks; ++i) {
+        sinks.push_back(std::make_unique<TestSink>(std::vector<TestSink::Spec>{
+            {.text = std::format("Prompt {}", i), .event = static_cast<EventID>(i + 1), .action = 1}}));
+        ASSERT_TRUE(Send(*sinks.back()));
+    }
+    Frames(1);
+    TestSink vip({{.text = "VIP", .event = 100, .action = 1}});
+    ASSERT_TRUE(Send(vip, 5));
+    Frames(1);
+    EXPECT_TRUE(Shown(vip));
+    RemovePrompt(&vip, client);
+
+    std::vector<int> timed_out(n_sinks, -1);
+    for (int frame = 0; frame < 3000 && std::ranges::count(timed_out, -1) > 0; ++frame) {
+        Headless::Tick();
+        int shown = 0;
+        for (int i = 0; i < n_sinks; ++i) {
+            shown += Shown(*sinks[i]);
+            if (timed_out[i] < 0 && sinks[i]->Count(kTimeout) > 0) {
+                timed_out[i] = frame;
+            }
+        }
+        ASSERT_LE(shown, 2);
+    }
+    for (int i = 0; i < n_sinks; ++i) {
+        EXPECT_EQ(sinks[i]->Count(kTimeout), 1u) << "sink " << i;
+    }
+    // waiting in line: the first ones sent are done before the last ones get a slot. 0 or 1 made way for vip and
+    // went to the back, so the line starts at 2.
+    for (int first = 2; first < 4; ++first) {
+        for (int last = n_sinks - 2; last < n_sinks; ++last) {
+            EXPECT_LT(timed_out[first], timed_out[last]);
+        }
+    }
+}
+
+TEST_F(SchedulerTest, PriorityEndsWithThePromptsThatTimedOut) {
+    Headless::Init(1);
+    MCP::Settings::lifetime = 0.5f;
+    TestSink vip({{.text = "VIP", .event = 1, .action = 1}});
+    ASSERT_TRUE(Send(vip, 5));
+    Frames(120);
+    ASSERT_EQ(vip.Count(kTimeout), 1u);
+
+    MCP::Settings::lifetime = 1e6f;
+    TestSink other({{.text = "Other", .event = 2, .action = 1}});
+    ASSERT_TRUE(Send(other));
+    Frames(2);
+    ASSERT_TRUE(Shown(other));
+
+    // sent again without a priority, so it queues behind other instead of pushing it out
+    ASSERT_TRUE(SendPrompt(&vip, client));
+    Frames(2);
+    EXPECT_TRUE(Shown(other));
+    EXPECT_FALSE(Shown(vip));
+}
+
+TEST_F(SchedulerTest, PriorityQueuesInOrderWithTheSinksCommands) {
+    Headless::Init(1);
+    TestSink other({{.text = "Other", .event = 2, .action = 1}});
+    TestSink vip({{.text = "VIP", .event = 1, .action = 1}});
+    ASSERT_TRUE(Send(vip, 5));
+    Frames(2);
+
+    // all before the next frame: the removal must not take the new priority with it
+    RemovePrompt(&vip, client);
+    ASSERT_TRUE(Send(other));
+    ASSERT_TRUE(Send(vip, 5));
+    Frames(2);
+    EXPECT_TRUE(Shown(vip));
+    EXPECT_FALSE(Shown(other));
+}
+
+TEST_F(SchedulerTest, PriorityBelongsToTheClientThatSetIt) {
+    Headless::Init(1);
+    const auto other_client = RequestClientID();
+    TestSink low({{.text = "Low", .event = 2, .action = 1}});
+    TestSink shared({{.text = "Shared", .event = 1, .action = 1}});
+    ASSERT_TRUE(Send(low));
+    Frames(2);
+
+    // set by another client, so it does not lift this client's send
+    ASSERT_TRUE(ProcessSetPromptPriority(&shared, other_client, 5));
+    ASSERT_TRUE(SendPrompt(&shared, client));
+    Frames(2);
+    EXPECT_TRUE(Shown(low));
+    EXPECT_FALSE(Shown(shared));
+}
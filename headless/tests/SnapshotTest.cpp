@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "Headless.h"
+#include "TestSink.h"
+
+using namespace SkyPromptAPI;
+
+// The prompt snapshot the input hook reads while the render thread keeps publishing new ones.
+
+namespace {
+    class SnapshotTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            Headless::Init();
+            client = RequestClientID();
+            ASSERT_NE(client, 0);
+        }
+
+        ClientID client = 0;
+    };
+
+    constexpr uint32_t SlotKey(const int a_slot) { return static_cast<uint32_t>(KEY::kNum1 + a_slot); }
+}
+
+TEST_F(SnapshotTest, PinnedBufferIsNotRefilled) {
+    const auto manager = MANAGER(ImGui::Renderer);
+    TestSink first({{.text = "First", .event = 1, .action = 1}});
+    TestSink second({{.text = "Second", .event = 2, .action = 1}});
+    ASSERT_TRUE(SendPrompt(&first, client));
+    Headless::Tick();
+
+    std::atomic<bool> done = false;
+    std::thread render;
+    {
+        const auto pinned = manager->GetSnapshot();
+        ASSERT_EQ(pinned->Find(SlotKey(0)).size(), 1u);
+
+        // the first publish goes to the other buffer; the one after that has to wait for the pin
+        render = std::thread([&] {
+            ASSERT_TRUE(SendPrompt(&second, client));
+            Headless::Tick();
+            RemovePrompt(&first, client);
+            Headless::Tick();
+            done = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_FALSE(done);
+        EXPECT_EQ(pinned->Find(SlotKey(0)).size(), 1u);
+        EXPECT_TRUE(pinned->Find(SlotKey(1)).empty());
+    }
+    render.join();
+    EXPECT_TRUE(done);
+}
+
+TEST_F(SnapshotTest, ReadersNeverSeeAHalfBuiltTable) {
+    constexpr int n_sinks = 6;
+    std::vector<std::unique_ptr<TestSink>> sinks;
+    for (int i = 0; i < n_sinks; ++i) {
+        sinks.push_back(std::make_unique<TestSink>(std::vector<TestSink::Spec>{
+            {.text = "Prompt", .event = static_cast<EventID>(i + 1), .action = 1}}));
+    }
+
+    std::atomic<bool> stop = false;
+    std::atomic<uint64_t> reads = 0;
+    std::atomic<uint64_t> bad = 0;
+    std::thread input([&] {
+        const auto manager = MANAGER(ImGui::Renderer);
+        while (!stop) {
+            const auto snapshot = manager->GetSnapshot();
+            for (int slot = 0; slot < n_sinks; ++slot) {
+                for (const auto& a_entry : snapshot->Find(SlotKey(slot))) {
+                    if (a_entry.key != SlotKey(slot) || !a_entry.manager || a_entry.managerID == 0) {
+                        ++bad;
+                    }
+                }
+            }
+            ++reads;
+        }
+    });
+
+    // different prompts every frame, so every frame publishes
+    for (int frame = 0; frame < 3000; ++frame) {
+        const auto& sink = sinks[static_cast<size_t>(frame % n_sinks)];
+        if (frame / n_sinks % 2 == 0) {
+            (void)SendPrompt(sink.get(), client);
+        } else {
+            RemovePrompt(sink.get(), client);
+        }
+        Headless::Tick();
+    }
+    stop = true;
+    input.join();
+    EXPECT_GT(reads.load(), 0u);
+    EXPECT_EQ(bad.load(), 0u);
+}
+
+TEST(PromptSnapshotTest, FindCoversEntriesPastSixteenBits) {
+    ImGui::Renderer::PromptSnapshot snapshot;
+    // appended in key order, which is what Insert would produce
+    snapshot.entries.resize(70'000, {.key = 5});
+    snapshot.entries.insert(snapshot.entries.end(), 3, {.key = 7});
+    snapshot.BuildTable();
+    EXPECT_EQ(snapshot.Find(5).size(), 70'000u);
+    ASSERT_EQ(snapshot.Find(7).size(), 3u);
+    EXPECT_EQ(snapshot.Find(7).data(), snapshot.entries.data() + 70'000);
+    EXPECT_TRUE(snapshot.Find(6).empty());
+}
+
+TEST_F(SnapshotTest, EdgesRoutedWhilePinnedAreNeverDropped) {
+    MCP::Settings::lifetime = 1e6f;
+    const auto manager = MANAGER(ImGui::Renderer);
+    TestSink sink({{.text = "Open", .event = 1, .action = 1}});
+    ASSERT_TRUE(SendPrompt(&sink, client));
+    Headless::Tick();
+    Headless::Tick();
+
+    // twice what the input ring holds, all before the next frame, each with the snapshot pinned like the hook does
+    constexpr int presses = 1024;
+    for (int i = 0; i < presses; ++i) {
+        for (const bool down : {true, false}) {
+            const auto snapshot = manager->GetSnapshot();
+            (void)manager->RouteInput(*snapshot, {.type = ImGui::Renderer::KeyInput::Type::kButton,
+                                                  .key = SlotKey(0), .pressed = down, .down = down, .up = !down,
+                                                  .time = std::chrono::steady_clock::now()});
+        }
+    }
+    Headless::Tick();
+    EXPECT_EQ(sink.Count(kDown), static_cast<size_t>(presses));
+    EXPECT_EQ(sink.Count(kUp), static_cast<size_t>(presses));
+}
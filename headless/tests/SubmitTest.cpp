@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <future>
+#include "Headless.h"
+#include "TestSink.h"
+
+using namespace SkyPromptAPI;
+
+// SendPrompt and RemovePrompt from the caller's side: they never wait for a frame, the queue works from a copy of the
+// prompts, and a removed sink is left alone from the moment RemovePrompt returns.
+
+namespace {
+    class SubmitTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            Headless::Init();
+            client = RequestClientID();
+            ASSERT_NE(client, 0);
+        }
+
+        ClientID client = 0;
+    };
+}
+
+TEST_F(SubmitTest, RemovePromptDoesNotWaitForARunningFrame) {
+    TestSink sink({{.text = "Open", .event = 1, .action = 1}});
+    ASSERT_TRUE(SendPrompt(&sink, client));
+    Headless::Tick();
+
+    // another thread sits inside a frame for as long as the removal takes
+    std::promise<void> removed;
+    std::promise<void> frame_started;
+    std::thread frame([&] {
+        const auto lock = MANAGER(ImGui::Renderer)->LockFrame();
+        frame_started.set_value();
+        removed.get_future().wait_for(std::chrono::seconds(5));
+    });
+    frame_started.get_future().wait();
+    const auto result = std::async(std::launch::async, [&] {
+        RemovePrompt(&sink, client);
+        removed.set_value();
+    });
+    EXPECT_EQ(result.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    frame.join();
+
+    Headless::Tick();
+    EXPECT_FALSE(MANAGER(ImGui::Renderer)->IsInQueue(client, &sink));
+}
+
+TEST_F(SubmitTest, QueueKeepsWhatWasSentUntilItIsResent) {
+    TestSink sink({{.text = "Open", .event = 1, .action = 1}});
+    ASSERT_TRUE(SendPrompt(&sink, client));
+    Headless::RecordTexts(true);
+    Headless::Tick();
+
+    sink.SetText(0, "Close");
+    Headless::Tick();
+    ASSERT_EQ(Headless::Draws().last_texts.size(), 1u);
+    EXPECT_EQ(Headless::Draws().last_texts[0], "Open");
+
+    EXPECT_FALSE(SendPrompt(&sink, client));
+    Headless::Tick();
+    EXPECT_EQ(Headless::Draws().last_texts[0], "Close");
+}
+
+TEST_F(SubmitTest, RemovedSinkGetsNoQueuedEvents) {
+    auto sink = std::make_unique<TestSink>(std::vector<TestSink::Spec>{{.text = "Open", .event = 1, .action = 1}});
+    size_t delivered = 0;
+    sink->on_event = [&delivered](const PromptEvent&) { ++delivered; };
+    ASSERT_TRUE(SendPrompt(sink.get(), client));
+    Headless::Tick();
+
+    const auto manager = MANAGER(ImGui::Renderer);
+    manager->AddEventToSend(sink.get(), sink->GetPrompts()[0], kDown, {}, nullptr);
+    RemovePrompt(sink.get(), client);
+    // freeing it right away is allowed
+    sink.reset();
+    for (int i = 0; i < 5; ++i) {
+        Headless::Tick();
+    }
+    EXPECT_EQ(delivered, 0u);
+}
+
+TEST_F(SubmitTest, PromptsThatCannotBeQueuedAreReportedToTheSink) {
+    TestSink sink({{.text = "Open", .event = 1, .action = 1}, {.text = "Take", .event = 1, .action = 2}});
+    // a client that was never handed out has no queues; SendPrompt itself would refuse it
+    EXPECT_TRUE(MANAGER(ImGui::Renderer)->Submit(&sink, 999));
+    Headless::Tick();
+    Headless::Tick();
+    EXPECT_EQ(sink.Count(kRemovedByMod), 2u);
+    EXPECT_FALSE(MANAGER(ImGui::Renderer)->IsInQueue(999, &sink));
+}
+
+TEST_F(SubmitTest, RemovePromptWaitsOutACallIntoTheSameSink) {
+    MCP::Settings::lifetime = 0.05f;
+    TestSink sink({{.text = "Open", .event = 1, .action = 1}});
+    std::atomic<bool> in_callback = false;
+    std::atomic<bool> release = false;
+    sink.on_event = [&](const PromptEvent&) {
+        in_callback = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+    };
+    ASSERT_TRUE(SendPrompt(&sink, client));
+
+    // frames run on their own thread until the first event blocks in the sink
+    std::thread frames([] {
+        for (int i = 0; i < 200; ++i) {
+            Headless::Tick();
+        }
+    });
+    while (!in_callback) {
+        std::this_thread::yield();
+    }
+    std::atomic<bool> returned = false;
+    std::thread remover([&] {
+        RemovePrompt(&sink, client);
+        returned = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(returned);
+    release = true;
+    remover.join();
+    EXPECT_TRUE(returned);
+    frames.join();
+    EXPECT_EQ(sink.Events().size(), 1u);
+}
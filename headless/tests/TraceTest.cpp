@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "Headless.h"
+#include "Service.h"
+#include "TestSink.h"
+#include "TraceReader.h"
+
+using namespace SkyPromptAPI;
+
+// A session recorded the way the plugin records one and read back. The file is left behind for the replay smoke
+// test, which plays it through SkyPromptReplay (see CMakeLists.txt).
+
+namespace {
+    std::filesystem::path TracePath() {
+        if (const auto path = std::getenv("SKYPROMPT_TRACE")) {
+            return path;
+        }
+        return std::filesystem::temp_directory_path() / "SkyPromptTraceTest.sptr";
+    }
+
+    // what the input hook does with a key press: record it, then route it
+    void Press(const float a_value, const float a_held) {
+        RE::ButtonEvent event;
+        event.device = RE::INPUT_DEVICE::kKeyboard;
+        event.idCode = KEY::kNum1;
+        event.value = a_value;
+        event.heldDownSecs = a_held;
+        MANAGER(Trace)->Input(&event);
+
+        const auto manager = MANAGER(ImGui::Renderer);
+        const auto snapshot = manager->GetSnapshot();
+        ASSERT_FALSE(snapshot->hidden);
+        (void)manager->RouteInput(*snapshot, {.type = ImGui::Renderer::KeyInput::Type::kButton, .key = KEY::kNum1,
+                                              .pressed = event.IsPressed(), .down = event.IsDown(),
+                                              .up = event.IsUp(), .time = std::chrono::steady_clock::now()});
+    }
+}
+
+TEST(TraceTest, RecordsASessionReplayCanRead) {
+    Headless::Init(2);
+    MCP::Settings::lifetime = 1e6f;
+    const auto path = TracePath();
+    ASSERT_TRUE(MANAGER(Trace)->Start(path));
+
+    const auto client = RequestClientID();
+    TestSink sink({{.text = "Open", .event = 1, .action = 2}});
+    ASSERT_TRUE(SendPrompt(&sink, client));
+    uint32_t frames = 0;
+    const auto tick = [&frames] { frames += Headless::Tick(); };
+    tick();
+    tick();
+    Press(1.f, 0.f);
+    tick();
+    Press(1.f, 0.1f);
+    tick();
+    Press(0.f, 0.2f);
+    tick();
+    RemovePrompt(&sink, client);
+    tick();
+    MANAGER(Trace)->Stop();
+    // the live session, which the replay of this trace should repeat
+    EXPECT_EQ(sink.Count(kDown), 1u);
+    EXPECT_EQ(sink.Count(kAccepted), 1u);
+    EXPECT_EQ(sink.Count(kUp), 1u);
+
+    Trace::Reader reader(path);
+    ASSERT_TRUE(reader.IsValid());
+    Trace::Record record;
+    std::map<Trace::Kind, int> kinds;
+    uint32_t last_frame = 0;
+    uint64_t sent_sink = 0;
+    while (reader.Next(record)) {
+        ++kinds[record.header.kind];
+        EXPECT_GE(record.header.frame, last_frame);
+        last_frame = record.header.frame;
+        if (record.header.kind == Trace::Kind::kSend) {
+            ASSERT_EQ(record.prompts.size(), 1u);
+            EXPECT_EQ(record.prompts[0].text, "Open");
+            EXPECT_EQ(record.prompts[0].record.event, 1u);
+            EXPECT_EQ(record.prompts[0].record.action, 2u);
+            sent_sink = record.send.sink;
+        } else if (record.header.kind == Trace::Kind::kButton) {
+            EXPECT_EQ(record.button.id_code, static_cast<uint32_t>(KEY::kNum1));
+        } else if (record.header.kind == Trace::Kind::kRemove) {
+            EXPECT_EQ(record.remove.sink, sent_sink);
+        }
+    }
+    EXPECT_EQ(kinds[Trace::Kind::kFrame], static_cast<int>(frames));
+    EXPECT_EQ(kinds[Trace::Kind::kSend], 1);
+    EXPECT_EQ(kinds[Trace::Kind::kButton], 3);
+    EXPECT_EQ(kinds[Trace::Kind::kRemove], 1);
+    EXPECT_EQ(last_frame, frames);
+}
+
+TEST(TraceTest, SendPastTheCountLimitStaysReadable) {
+    const auto path = TracePath().replace_extension(".limit.sptr");
+    ASSERT_TRUE(MANAGER(Trace)->Start(path));
+    TestSink sink({{.text = "Open", .event = 1, .action = 2}});
+    const std::vector prompts(std::numeric_limits<uint16_t>::max() + 2, sink.GetPrompts().front());
+    MANAGER(Trace)->Send(&sink, 1, prompts);
+    MANAGER(Trace)->Remove(&sink, 1);
+    MANAGER(Trace)->Stop();
+
+    // the record holds as many prompts as it says, so the one after it is read whole
+    Trace::Reader reader(path);
+    ASSERT_TRUE(reader.IsValid());
+    Trace::Record record;
+    ASSERT_TRUE(reader.Next(record));
+    ASSERT_EQ(record.header.kind, Trace::Kind::kSend);
+    EXPECT_EQ(record.prompts.size(), std::numeric_limits<uint16_t>::max());
+    ASSERT_TRUE(reader.Next(record));
+    EXPECT_EQ(record.header.kind, Trace::Kind::kRemove);
+    EXPECT_EQ(record.remove.client, 1u);
+    EXPECT_FALSE(reader.Next(record));
+    std::filesystem::remove(path);
+}
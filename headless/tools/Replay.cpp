@@ -0,0 +1,276 @@
+#include <ctime>
+#include <thread>
+#include "Counters.h"
+#include "Headless.h"
+#include "TraceReader.h"
+
+// Plays a trace recorded in the game back through the headless core: the same API calls, the input routed the way
+// the input hook routes it and one frame per recorded frame, at the recorded pace unless --fast. Prints what each
+// frame cost and every event the sinks were sent, so a change can be tried against the session it is meant to help.
+//
+//   SkyPromptReplay <trace> [--slots N] [--fast] [--quiet]
+
+namespace {
+    struct Options {
+        std::filesystem::path path;
+        int slots = 8;
+        // do not wait for the recorded time between frames; gestures that depend on timing may then differ
+        bool fast = false;
+        // the summary only
+        bool quiet = false;
+    };
+
+    struct Delivered {
+        size_t sink;
+        SkyPromptAPI::PromptEvent event;
+        std::string text;
+    };
+
+    // events since the last frame line was printed
+    std::vector<Delivered> delivered;
+
+    // one sink of the recorded session, holding copies of the prompts it was last sent with
+    class ReplaySink final : public SkyPromptAPI::PromptSink {
+    public:
+        explicit ReplaySink(const size_t a_index) : index_(a_index) {}
+
+        void Set(const std::vector<Trace::SentPrompt>& a_prompts) {
+            texts_.clear();
+            keys_.clear();
+            prompts_.clear();
+            for (const auto& [record, text, keys] : a_prompts) {
+                texts_.push_back(text);
+                auto& a_keys = keys_.emplace_back();
+                for (const auto& [device, key] : keys) {
+                    a_keys.emplace_back(static_cast<RE::INPUT_DEVICE>(device), key);
+                }
+            }
+            for (size_t i = 0; i < a_prompts.size(); ++i) {
+                const auto& record = a_prompts[i].record;
+                prompts_.emplace_back(texts_[i], record.event, record.action,
+                                      static_cast<SkyPromptAPI::PromptType>(record.type), record.refid, keys_[i],
+                                      record.text_color, record.progress);
+            }
+        }
+
+        [[nodiscard]] std::span<const SkyPromptAPI::Prompt> GetPrompts() const override { return prompts_; }
+
+        void ProcessEvent(const SkyPromptAPI::PromptEvent a_event) const override {
+            // the text is a view into the core's copy, which may be gone once this returns
+            delivered.push_back({index_, a_event, std::string(a_event.prompt.text)});
+        }
+
+    private:
+        size_t index_;
+        std::vector<std::string> texts_;
+        std::vector<std::vector<std::pair<RE::INPUT_DEVICE, SkyPromptAPI::ButtonID>>> keys_;
+        std::vector<SkyPromptAPI::Prompt> prompts_;
+    };
+
+    constexpr std::array<std::string_view, SkyPromptAPI::kTotalEventTypes> event_names = {
+        "kAccepted", "kDeclined", "kUp", "kDown", "kTimeout", "kTimingOut", "kRemovedByMod", "kMove"};
+
+    uint64_t ThreadCpuNs() {
+        timespec ts{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    class Session {
+    public:
+        explicit Session(const Options& a_options) : options_(a_options) {}
+
+        void Apply(const Trace::Record& a_record) {
+            using Trace::Kind;
+            switch (a_record.header.kind) {
+                case Kind::kFrame:
+                    Frame(a_record);
+                    break;
+                case Kind::kButton: {
+                    const auto& [id_code, device, value, held_down_secs] = a_record.button;
+                    // RE::ButtonEvent's IsPressed, IsDown and IsUp
+                    Route({.type = ImGui::Renderer::KeyInput::Type::kButton,
+                           .key = Input::Manager::Convert(id_code, static_cast<RE::INPUT_DEVICE>(device)),
+                           .pressed = value > 0.f, .down = value > 0.f && held_down_secs == 0.f,
+                           .up = value == 0.f && held_down_secs > 0.f, .time = std::chrono::steady_clock::now()});
+                    break;
+                }
+                case Kind::kMouseMove:
+                    Route({.type = ImGui::Renderer::KeyInput::Type::kMove, .key = SkyPromptAPI::kMouseMove,
+                           .delta = {static_cast<float>(a_record.mouse_move.x),
+                                     static_cast<float>(a_record.mouse_move.y)}});
+                    break;
+                case Kind::kThumbstick:
+                    Route({.type = ImGui::Renderer::KeyInput::Type::kMove,
+                           .key = a_record.thumbstick.left ? SkyPromptAPI::kThumbstickMoveL
+                                                           : SkyPromptAPI::kThumbstickMoveR,
+                           .delta = {a_record.thumbstick.x, a_record.thumbstick.y}});
+                    break;
+                case Kind::kSend: {
+                    auto& sink = Sink(a_record.send.sink);
+                    sink.Set(a_record.prompts);
+                    for (const auto& a_prompt : a_record.prompts) {
+                        if (a_prompt.record.refid) {
+                            (void)Headless::AddReference(a_prompt.record.refid);
+                        }
+                    }
+                    (void)SkyPromptAPI::SendPrompt(&sink, Client(a_record.send.client));
+                    break;
+                }
+                case Kind::kRemove:
+                    SkyPromptAPI::RemovePrompt(&Sink(a_record.remove.sink), Client(a_record.remove.client));
+                    break;
+            }
+        }
+
+        void PrintSummary() const {
+            auto sorted = cpu_ns_;
+            std::ranges::sort(sorted);
+            const auto percentile = [&sorted](const double a_p) {
+                return sorted.empty() ? 0.0 : static_cast<double>(
+                           sorted[static_cast<size_t>(a_p * static_cast<double>(sorted.size() - 1))]) / 1000.0;
+            };
+            const auto mean = sorted.empty() ? 0.0 : static_cast<double>(std::accumulate(
+                                  sorted.begin(), sorted.end(), uint64_t{0})) / static_cast<double>(sorted.size()) /
+                              1000.0;
+            std::printf("frames %zu (idle %zu) | cpu us mean %8.2f p50 %8.2f p99 %8.2f max %8.2f (frame %u)\n",
+                        cpu_ns_.size(), idle_, mean, percentile(0.5), percentile(0.99), percentile(1.0),
+                        slowest_frame_);
+            std::printf("sinks %zu | clients %zu | events", sinks_.size(), clients_.size());
+            for (size_t i = 0; i < event_names.size(); ++i) {
+                std::printf(" %.*s %llu", static_cast<int>(event_names[i].size()), event_names[i].data(),
+                            static_cast<unsigned long long>(event_counts_[i]));
+            }
+            std::printf("\n");
+        }
+
+        // events sent outside a frame, by the API calls after the last one
+        void Flush() { PrintEvents(); }
+
+    private:
+        const Options& options_;
+        std::map<uint64_t, std::unique_ptr<ReplaySink>> sinks_;
+        std::map<SkyPromptAPI::ClientID, SkyPromptAPI::ClientID> clients_;
+        std::vector<uint64_t> cpu_ns_;
+        size_t idle_ = 0;
+        uint32_t frame_ = 0;
+        uint64_t slowest_ns_ = 0;
+        uint32_t slowest_frame_ = 0;
+        std::array<uint64_t, SkyPromptAPI::kTotalEventTypes> event_counts_{};
+        std::chrono::steady_clock::time_point started_ = std::chrono::steady_clock::now();
+
+        // numbered in the order the trace first mentions them, so two replays of a trace print the same
+        ReplaySink& Sink(const uint64_t a_recorded) {
+            auto& sink = sinks_[a_recorded];
+            if (!sink) {
+                sink = std::make_unique<ReplaySink>(sinks_.size() - 1);
+            }
+            return *sink;
+        }
+
+        SkyPromptAPI::ClientID Client(const SkyPromptAPI::ClientID a_recorded) {
+            auto& client = clients_[a_recorded];
+            if (client == 0) {
+                client = SkyPromptAPI::RequestClientID();
+            }
+            return client;
+        }
+
+        // what InputHook::ProcessInput does once the game's event is decoded
+        static void Route(const ImGui::Renderer::KeyInput& a_input) {
+            const auto manager = MANAGER(ImGui::Renderer);
+            if (manager->IsPaused()) {
+                return;
+            }
+            if (const auto snapshot = manager->GetSnapshot(); !snapshot->hidden) {
+                (void)manager->RouteInput(*snapshot, a_input);
+            }
+        }
+
+        void Frame(const Trace::Record& a_record) {
+            frame_ = a_record.header.frame;
+            if (!options_.fast) {
+                std::this_thread::sleep_until(started_ + std::chrono::microseconds(a_record.frame.micros));
+            }
+            Headless::SetFrameDelta(a_record.frame.seconds_since_last_frame);
+            const auto start_counters = Counters::Now();
+            const auto start_ns = ThreadCpuNs();
+            const bool rendered = Headless::Tick();
+            const auto cpu_ns = ThreadCpuNs() - start_ns;
+            const auto counters = Counters::Now() - start_counters;
+
+            if (cpu_ns >= slowest_ns_) {
+                slowest_ns_ = cpu_ns;
+                slowest_frame_ = frame_;
+            }
+            cpu_ns_.push_back(cpu_ns);
+            idle_ += !rendered;
+            if (!options_.quiet) {
+                std::printf("frame %u cpu us %8.2f | locks %3llu | allocs %4llu%s\n", frame_,
+                            static_cast<double>(cpu_ns) / 1000.0, static_cast<unsigned long long>(counters.locks),
+                            static_cast<unsigned long long>(counters.allocations), rendered ? "" : " | idle");
+            }
+            PrintEvents();
+        }
+
+        void PrintEvents() {
+            for (const auto& [sink, event, text] : delivered) {
+                ++event_counts_[event.type];
+                if (!options_.quiet) {
+                    const auto& name = event_names[event.type];
+                    std::printf("  sink %zu %-13.*s event %u action %u \"%s\" delta %g %g\n", sink,
+                                static_cast<int>(name.size()), name.data(), event.prompt.eventID,
+                                event.prompt.actionID, text.c_str(), event.delta.first, event.delta.second);
+                }
+            }
+            delivered.clear();
+        }
+    };
+
+    void Usage() {
+        std::fputs("usage: SkyPromptReplay <trace> [--slots N] [--fast] [--quiet]\n", stderr);
+    }
+}
+
+int main(const int argc, char** argv) {
+    if (argc < 2) {
+        Usage();
+        return 2;
+    }
+    Options options;
+    options.path = argv[1];
+    for (int i = 2; i < argc; ++i) {
+        const std::string_view flag = argv[i];
+        if (flag == "--slots" && i + 1 < argc) {
+            options.slots = std::max(std::atoi(argv[++i]), 1);
+        } else if (flag == "--fast") {
+            options.fast = true;
+        } else if (flag == "--quiet") {
+            options.quiet = true;
+        } else {
+            Usage();
+            return 2;
+        }
+    }
+
+    Trace::Reader reader(options.path);
+    if (!reader.IsValid()) {
+        std::fprintf(stderr, "%s is not a SkyPrompt trace of version %u\n", options.path.string().c_str(),
+                     Trace::version);
+        return 1;
+    }
+
+    spdlog::set_level(spdlog::level::warn);
+    Headless::Init(options.slots);
+    Session session(options);
+    Trace::Record record;
+    size_t records = 0;
+    while (reader.Next(record)) {
+        session.Apply(record);
+        ++records;
+    }
+    session.Flush();
+    std::printf("%s: %zu records\n", options.path.string().c_str(), records);
+    session.PrintSummary();
+    return 0;
+}
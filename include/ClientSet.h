@@ -0,0 +1,120 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <optional>
+#include "SkyPrompt/API.hpp"
+
+// Set over the whole ClientID range as a two-level bitset. A summary word marks which leaf words are non-empty,
+// so finding the next or previous member reads at most one leaf word per level plus the 16 summary words.
+class ClientSet {
+    using ClientID = SkyPromptAPI::ClientID;
+
+    static constexpr size_t n_words = (size_t{std::numeric_limits<ClientID>::max()} + 1) / 64;
+    static constexpr size_t n_summary = n_words / 64;
+
+public:
+    void Set(const ClientID a_id, const bool a_value) {
+        const size_t w = a_id >> 6;
+        const auto bit = uint64_t{1} << (a_id & 63);
+        if (((words_[w] & bit) != 0) == a_value) {
+            return;
+        }
+        words_[w] ^= bit;
+        a_value ? ++count_ : --count_;
+        ++version_;
+        if (words_[w]) {
+            summary_[w >> 6] |= uint64_t{1} << (w & 63);
+        } else {
+            summary_[w >> 6] &= ~(uint64_t{1} << (w & 63));
+        }
+    }
+
+    [[nodiscard]] bool Test(const ClientID a_id) const { return words_[a_id >> 6] >> (a_id & 63) & 1; }
+    [[nodiscard]] size_t Count() const { return count_; }
+    // changes whenever a member is added or removed
+    [[nodiscard]] size_t Version() const { return version_; }
+
+    // number of members smaller than a_id; reads up to 16 summary words and every non-empty leaf word below a_id
+    [[nodiscard]] size_t Rank(const ClientID a_id) const {
+        size_t rank = 0;
+        const size_t last = a_id >> 6;
+        for (size_t s = 0; s <= last >> 6; ++s) {
+            for (auto m = summary_[s]; m; m &= m - 1) {
+                const size_t w = s * 64 + std::countr_zero(m);
+                if (w >= last) {
+                    break;
+                }
+                rank += std::popcount(words_[w]);
+            }
+        }
+        return rank + std::popcount(words_[last] & ((uint64_t{1} << (a_id & 63)) - 1));
+    }
+
+    // smallest member >= a_from
+    [[nodiscard]] std::optional<ClientID> First(const size_t a_from) const {
+        if (a_from >= n_words * 64) {
+            return std::nullopt;
+        }
+        size_t w = a_from >> 6;
+        if (const auto m = words_[w] & (~uint64_t{0} << (a_from & 63))) {
+            return static_cast<ClientID>(w * 64 + std::countr_zero(m));
+        }
+        if (++w == n_words) {
+            return std::nullopt;
+        }
+        for (size_t s = w >> 6; s < n_summary; ++s) {
+            const auto m = s == w >> 6 ? summary_[s] & (~uint64_t{0} << (w & 63)) : summary_[s];
+            if (m) {
+                const size_t found = s * 64 + std::countr_zero(m);
+                return static_cast<ClientID>(found * 64 + std::countr_zero(words_[found]));
+            }
+        }
+        return std::nullopt;
+    }
+
+    // largest member <= a_from
+    [[nodiscard]] std::optional<ClientID> Last(const size_t a_from) const {
+        size_t w = std::min(a_from, n_words * 64 - 1) >> 6;
+        const auto bits = std::min(a_from, n_words * 64 - 1) & 63;
+        if (const auto m = words_[w] & (~uint64_t{0} >> (63 - bits))) {
+            return static_cast<ClientID>(w * 64 + 63 - std::countl_zero(m));
+        }
+        if (w-- == 0) {
+            return std::nullopt;
+        }
+        for (size_t s = (w >> 6) + 1; s-- > 0;) {
+            const auto m = s == w >> 6 ? summary_[s] & (~uint64_t{0} >> (63 - (w & 63))) : summary_[s];
+            if (m) {
+                const size_t found = s * 64 + 63 - std::countl_zero(m);
+                return static_cast<ClientID>(found * 64 + 63 - std::countl_zero(words_[found]));
+            }
+        }
+        return std::nullopt;
+    }
+
+    // the member after (or before) a_id, wrapping around; never a_id itself
+    [[nodiscard]] std::optional<ClientID> Neighbour(const ClientID a_id, const bool a_left) const {
+        std::optional<ClientID> found;
+        if (a_left) {
+            found = a_id > 0 ? Last(a_id - 1) : std::nullopt;
+            if (!found) {
+                found = Last(n_words * 64 - 1);
+            }
+        } else {
+            found = First(size_t{a_id} + 1);
+            if (!found) {
+                found = First(0);
+            }
+        }
+        if (found == a_id) {
+            return std::nullopt;
+        }
+        return found;
+    }
+
+private:
+    std::array<uint64_t, n_words> words_{};
+    std::array<uint64_t, n_summary> summary_{};
+    size_t count_ = 0;
+    size_t version_ = 0;
+};
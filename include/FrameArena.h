@@ -0,0 +1,95 @@
+#pragma once
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Bump allocator for data that only lives until the end of the current frame.
+// Reset() rewinds it without freeing anything, so once a frame has been seen at its largest the arena stops
+// touching the heap.
+class FrameArena {
+public:
+    explicit FrameArena(const size_t a_block_size = 16 * 1024) : block_size_(a_block_size) {}
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* Allocate(const size_t a_size, const size_t a_align = alignof(std::max_align_t)) {
+        for (;;) {
+            if (block_ < blocks_.size()) {
+                auto& [data, capacity] = blocks_[block_];
+                const size_t offset = (offset_ + a_align - 1) & ~(a_align - 1);
+                if (offset + a_size <= capacity) {
+                    offset_ = offset + a_size;
+                    used_ += a_size;
+                    return data.get() + offset;
+                }
+                ++block_;
+                offset_ = 0;
+                continue;
+            }
+            const size_t capacity = std::max(block_size_, a_size + a_align);
+            blocks_.push_back({std::make_unique<std::byte[]>(capacity), capacity});
+        }
+    }
+
+    // Only for types that need no destructor; the arena never runs any.
+    template <class T>
+    std::span<T> MakeArray(const size_t a_count) {
+        static_assert(std::is_trivially_destructible_v<T>);
+        if (a_count == 0) {
+            return {};
+        }
+        auto* data = static_cast<T*>(Allocate(sizeof(T) * a_count, alignof(T)));
+        std::uninitialized_value_construct_n(data, a_count);
+        return {data, a_count};
+    }
+
+    // Null-terminated copy that stays valid until the next Reset().
+    const char* Copy(const std::string_view a_text) {
+        auto* data = static_cast<char*>(Allocate(a_text.size() + 1, 1));
+        std::memcpy(data, a_text.data(), a_text.size());
+        data[a_text.size()] = '\0';
+        return data;
+    }
+
+    template <class... Args>
+    const char* Format(fmt::format_string<Args...> a_fmt, Args&&... a_args) {
+        const auto size = fmt::formatted_size(a_fmt, std::forward<Args>(a_args)...);
+        auto* data = static_cast<char*>(Allocate(size + 1, 1));
+        fmt::format_to(data, a_fmt, std::forward<Args>(a_args)...);
+        data[size] = '\0';
+        return data;
+    }
+
+    void Reset() {
+        // a frame that spilled over several blocks gets one block big enough for all of it
+        if (blocks_.size() > 1) {
+            size_t total = 0;
+            for (const auto& a_block : blocks_) {
+                total += a_block.capacity;
+            }
+            blocks_.clear();
+            blocks_.push_back({std::make_unique<std::byte[]>(total), total});
+        }
+        block_ = 0;
+        offset_ = 0;
+        used_ = 0;
+    }
+
+    [[nodiscard]] size_t Used() const { return used_; }
+    [[nodiscard]] size_t BlockCount() const { return blocks_.size(); }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t capacity;
+    };
+
+    std::vector<Block> blocks_;
+    size_t block_size_;
+    size_t block_ = 0;
+    size_t offset_ = 0;
+    size_t used_ = 0;
+};
@@ -21,9 +21,19 @@ namespace ImGui::Renderer {
         static inline REL::Relocation<decltype(thunk)> func;
     };
 
+    // frames that ran the ImGui pipeline and the time spent in it, and frames skipped because nothing was shown
+    struct DrawStats {
+        uint64_t drawn = 0;
+        uint64_t skipped = 0;
+        double draw_seconds = 0.0;
+    };
+
     struct DrawHook {
         static void thunk(std::uint32_t a_timer);
         static inline REL::Relocation<decltype(thunk)> func;
+
+        using Stats = DrawStats;
+        static inline Stats stats;
     };
 
     struct InputHook {
@@ -0,0 +1,115 @@
+#pragma once
+#include <vector>
+
+// Binary max-heap that also knows where each key sits, so entries can be looked up or removed by key in O(log n).
+// Equal scores come out in insertion order.
+template <class Key, class Score>
+class IndexedHeap {
+    struct Node {
+        Key key;
+        Score score;
+        uint64_t seq;
+    };
+
+public:
+    [[nodiscard]] bool Empty() const { return nodes_.empty(); }
+    [[nodiscard]] size_t Size() const { return nodes_.size(); }
+    [[nodiscard]] bool Contains(const Key& a_key) const { return positions_.contains(a_key); }
+
+    [[nodiscard]] const Key& Top() const { return nodes_.front().key; }
+    [[nodiscard]] Score TopScore() const { return nodes_.front().score; }
+
+    // false if the key is already in the heap; its score is left alone
+    bool Push(const Key& a_key, const Score a_score) {
+        if (positions_.contains(a_key)) {
+            return false;
+        }
+        nodes_.push_back({a_key, a_score, next_seq_++});
+        positions_[a_key] = nodes_.size() - 1;
+        SiftUp(nodes_.size() - 1);
+        return true;
+    }
+
+    Key Pop() {
+        Key key = nodes_.front().key;
+        RemoveAt(0);
+        return key;
+    }
+
+    bool Erase(const Key& a_key) {
+        const auto it = positions_.find(a_key);
+        if (it == positions_.end()) {
+            return false;
+        }
+        RemoveAt(it->second);
+        return true;
+    }
+
+    void Clear() {
+        nodes_.clear();
+        positions_.clear();
+    }
+
+    [[nodiscard]] auto begin() const { return nodes_.begin(); }
+    [[nodiscard]] auto end() const { return nodes_.end(); }
+
+private:
+    std::vector<Node> nodes_;
+    Map<Key, size_t> positions_;
+    uint64_t next_seq_ = 0;
+
+    static bool Before(const Node& a, const Node& b) { return a.score > b.score || (a.score == b.score && a.seq < b.seq); }
+
+    void Place(const size_t a_index, Node&& a_node) {
+        positions_[a_node.key] = a_index;
+        nodes_[a_index] = std::move(a_node);
+    }
+
+    void SiftUp(size_t a_index) {
+        Node node = std::move(nodes_[a_index]);
+        while (a_index > 0) {
+            const size_t parent = (a_index - 1) / 2;
+            if (!Before(node, nodes_[parent])) {
+                break;
+            }
+            Place(a_index, std::move(nodes_[parent]));
+            a_index = parent;
+        }
+        Place(a_index, std::move(node));
+    }
+
+    void SiftDown(size_t a_index) {
+        Node node = std::move(nodes_[a_index]);
+        for (;;) {
+            size_t child = 2 * a_index + 1;
+            if (child >= nodes_.size()) {
+                break;
+            }
+            if (child + 1 < nodes_.size() && Before(nodes_[child + 1], nodes_[child])) {
+                ++child;
+            }
+            if (!Before(nodes_[child], node)) {
+                break;
+            }
+            Place(a_index, std::move(nodes_[child]));
+            a_index = child;
+        }
+        Place(a_index, std::move(node));
+    }
+
+    void RemoveAt(const size_t a_index) {
+        positions_.erase(nodes_[a_index].key);
+        if (a_index == nodes_.size() - 1) {
+            nodes_.pop_back();
+            return;
+        }
+        nodes_[a_index] = std::move(nodes_.back());
+        nodes_.pop_back();
+        positions_[nodes_[a_index].key] = a_index;
+        if (a_index > 0 && Before(nodes_[a_index], nodes_[(a_index - 1) / 2])) {
+            SiftUp(a_index);
+        } else {
+            SiftDown(a_index);
+        }
+    }
+};
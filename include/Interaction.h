@@ -15,11 +15,6 @@ struct Interaction {
 
     Interaction() = default;
 
-    Interaction(const Interaction& a_rhs) {
-        action = a_rhs.action;
-        event = a_rhs.event;
-    }
-
     Interaction(const SCENES::Event& a_event, const ACTIONS::Action& a_action) : action(a_action), event(a_event) {
     }
 
@@ -27,4 +22,6 @@ struct Interaction {
         return event == a_rhs.event ? action < a_rhs.action : event < a_rhs.event;
     };
     bool operator==(const Interaction& a_rhs) const { return action == a_rhs.action && event == a_rhs.event; }
+
+    [[nodiscard]] uint64_t Key() const { return static_cast<uint64_t>(event) << 32 | action; }
 };
\ No newline at end of file
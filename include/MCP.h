@@ -13,6 +13,7 @@ namespace MCP {
     void __stdcall RenderControls();
     void __stdcall RenderTheme();
     void __stdcall RenderLog();
+    void __stdcall RenderPerformance();
     void Register();
 
     namespace Settings {
@@ -23,6 +24,8 @@ namespace MCP {
         inline std::map<Input::DEVICE, std::vector<uint32_t>> prompt_keys;
         inline std::map<Input::DEVICE, uint32_t> cycle_L;
         inline std::map<Input::DEVICE, uint32_t> cycle_R;
+        // bumped whenever prompt_keys or the loaded icons change, so buttons resolve their key and icon again
+        inline std::atomic<uint32_t> bindings_version{1};
 
         inline std::atomic shouldReloadPromptSize = true;
         inline std::atomic shouldReloadLifetime = true;
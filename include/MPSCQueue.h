@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <optional>
+
+// Bounded lock-free queue: any number of producers, one consumer at a time.
+// Based on Dmitry Vyukov's bounded array queue; every cell carries a sequence number so producers never block
+// each other and the consumer never blocks producers.
+template <class T, size_t N>
+class MPSCQueue {
+    static_assert(N > 1 && (N & (N - 1)) == 0, "MPSCQueue capacity must be a power of two");
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+public:
+    MPSCQueue() {
+        for (size_t i = 0; i < N; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    // Returns the ticket of the pushed element, or nullopt if the queue is full.
+    std::optional<size_t> TryPush(const T& a_value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & (N - 1)];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            if (const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos); diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = a_value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return pos;
+                }
+            } else if (diff < 0) {
+                return std::nullopt;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer side. Callers must make sure only one thread pops at a time.
+    bool TryPop(T& a_out) {
+        Cell& cell = cells_[dequeue_pos_ & (N - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+            return false;
+        }
+        a_out = std::move(cell.data);
+        cell.sequence.store(dequeue_pos_ + N, std::memory_order_release);
+        ++dequeue_pos_;
+        return true;
+    }
+
+    // Consumer side, like TryPop.
+    [[nodiscard]] bool Empty() const {
+        return cells_[dequeue_pos_ & (N - 1)].sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1;
+    }
+
+    // Number of elements popped so far; a ticket t has been consumed once Consumed() > t.
+    [[nodiscard]] size_t Consumed() const { return dequeue_pos_; }
+
+private:
+    alignas(64) std::array<Cell, N> cells_;
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) size_t dequeue_pos_ = 0;
+};
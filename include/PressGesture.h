@@ -0,0 +1,126 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+// Press-count gestures on a prompt's button, as a transition table over the number of presses in the current burst.
+// On prompts with progress, two quick presses decline the prompt, three skip to the next one, and holding the third
+// press until the circle fills deletes the whole queue; after the third, every further press skips straight away.
+// Nothing here knows about the game: SubManager feeds it timestamped input and carries out the actions.
+namespace PressGesture {
+    using Clock = std::chrono::steady_clock;
+
+    enum class Event : std::uint8_t {
+        kDown,         // the button went down
+        kUp,           // the button was released
+        kLongRelease,  // released after holding through at least one progress step
+        kQuiet,        // released, and the last press is older than the press interval
+        kSettled,      // released, still within the press interval
+        kHoldComplete, // the progress circle filled up
+        kTotal
+    };
+
+    enum class Action : std::uint8_t {
+        kNone,
+        kDecline,
+        kSkip,
+        kDeleteAll,
+        kAccept
+    };
+
+    struct Transition {
+        std::uint8_t next = 0;
+        Action action = Action::kNone;
+    };
+
+    inline constexpr std::uint8_t max_presses = 6;
+
+    // [has progress][presses][event]
+    using Table = std::array<std::array<std::array<Transition, static_cast<size_t>(Event::kTotal)>, max_presses + 1>,
+                             2>;
+
+    constexpr Table BuildTable() {
+        Table table{};
+        for (size_t progress = 0; progress < 2; ++progress) {
+            for (std::uint8_t n = 0; n <= max_presses; ++n) {
+                auto& row = table[progress][n];
+                const auto set = [&row](const Event a_event, const std::uint8_t a_next, const Action a_action) {
+                    row[static_cast<size_t>(a_event)] = {a_next, a_action};
+                };
+                set(Event::kDown, n < max_presses ? n + 1 : max_presses, Action::kNone);
+                set(Event::kUp, n, Action::kNone);
+                set(Event::kLongRelease, 0, Action::kNone);
+                if (!progress) {
+                    // plain prompts only accept; the count is only kept so the burst ends, and with it the
+                    // per-frame checks of HasPendingActions
+                    set(Event::kQuiet, 0, Action::kNone);
+                    set(Event::kSettled, n, Action::kNone);
+                    set(Event::kHoldComplete, n, Action::kAccept);
+                    continue;
+                }
+                set(Event::kQuiet, 0, n == 2 ? Action::kDecline : n == 3 ? Action::kSkip : Action::kNone);
+                if (n == 4 || n == max_presses) {
+                    set(Event::kSettled, 5, Action::kSkip);
+                } else {
+                    set(Event::kSettled, n, Action::kNone);
+                }
+                if (n == 3) {
+                    set(Event::kHoldComplete, 0, Action::kDeleteAll);
+                } else {
+                    set(Event::kHoldComplete, n, Action::kAccept);
+                }
+            }
+        }
+        return table;
+    }
+
+    inline constexpr Table table = BuildTable();
+
+    struct Machine {
+        std::uint8_t presses = 0;
+        bool pressing = false;
+        Clock::time_point last_press{};
+
+        constexpr Action Feed(const Event a_event, const bool a_has_progress) {
+            const auto& [next, action] = table[a_has_progress][presses][static_cast<size_t>(a_event)];
+            presses = next;
+            return action;
+        }
+
+        // a button event at a_time: an edge, or a repeat while held
+        constexpr Action Button(const bool a_pressed, const bool a_down, const Clock::time_point a_time,
+                                const bool a_has_progress) {
+            pressing = a_pressed;
+            if (a_down) {
+                last_press = a_time;
+                return Feed(Event::kDown, a_has_progress);
+            }
+            return a_pressed ? Action::kNone : Feed(Event::kUp, a_has_progress);
+        }
+
+        // checked every frame: once the button is released, the burst settles or times out
+        constexpr Action Tick(const Clock::time_point a_now, const Clock::duration a_interval,
+                              const bool a_has_progress) {
+            if (pressing) {
+                return Action::kNone;
+            }
+            return Feed(a_now - last_press > a_interval ? Event::kQuiet : Event::kSettled, a_has_progress);
+        }
+
+        constexpr void Reset() {
+            pressing = false;
+            presses = 0;
+        }
+
+        // what the progress circle shows: presses so far, not counting one that is still held before the third
+        [[nodiscard]] constexpr float Display() const {
+            const int shown = presses - (pressing && presses < 3 ? 1 : 0);
+            return static_cast<float>(shown) + 0.1f;
+        }
+    };
+
+    static_assert(table[1][2][static_cast<size_t>(Event::kQuiet)].action == Action::kDecline);
+    static_assert(table[1][3][static_cast<size_t>(Event::kQuiet)].action == Action::kSkip);
+    static_assert(table[1][3][static_cast<size_t>(Event::kHoldComplete)].action == Action::kDeleteAll);
+    static_assert(table[0][3][static_cast<size_t>(Event::kHoldComplete)].action == Action::kAccept);
+}
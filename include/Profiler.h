@@ -0,0 +1,164 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <chrono>
+#include <fstream>
+#include <intrin.h>
+#include <string_view>
+
+// Per-stage frame timing. Scoped timers read the TSC on entry and exit; every stage keeps its last ring_size samples
+// and a histogram over exactly those samples, updated as samples enter and leave the ring, so percentiles cost a walk
+// over the buckets and recording costs two counter updates. Ticks are converted to time only when reporting.
+// Everything runs on the render thread.
+namespace Profiler {
+    enum class Stage : std::uint8_t {
+        kDrawHook,
+        kStyleRefresh,
+        kReloadFonts,
+        kSubmissions,
+        kInputs,
+        kDeferred,
+        kSendEvents,
+        kCleanUpQueue,
+        kAdmitWaiting,
+        kShowQueue,
+        kRenderSkyPrompt,
+        kTotal
+    };
+
+    inline constexpr std::array<std::string_view, static_cast<size_t>(Stage::kTotal)> stage_names = {
+        "DrawHook", "OnStyleRefresh", "ReloadFonts", "ProcessSubmissions", "ProcessInputs", "RunDeferred",
+        "SendEvents", "CleanUpQueue", "AdmitWaiting", "ShowQueue", "RenderSkyPrompt"
+    };
+
+    inline uint64_t Ticks() { return __rdtsc(); }
+
+    inline const auto clock_start = std::chrono::steady_clock::now();
+    inline const auto tsc_start = Ticks();
+
+    // TSC ticks per microsecond, measured against steady_clock over the time since the plugin loaded
+    inline double TicksPerMicro() {
+        const auto micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - clock_start);
+        if (micros.count() < 1000.0) {
+            return 0.0;
+        }
+        return static_cast<double>(Ticks() - tsc_start) / micros.count();
+    }
+
+    class Histogram {
+        // four sub-buckets per power of two
+        static constexpr size_t sub_bits = 2;
+        static constexpr size_t n_buckets = 33 << sub_bits;
+
+    public:
+        static constexpr size_t ring_size = 1024;
+
+        void Record(const uint64_t a_ticks) {
+            const auto ticks = static_cast<uint32_t>(std::min<uint64_t>(a_ticks, std::numeric_limits<uint32_t>::max()));
+            auto& slot = ring_[next_ % ring_size];
+            if (next_ >= ring_size) {
+                --buckets_[Bucket(slot)];
+            }
+            slot = ticks;
+            ++buckets_[Bucket(ticks)];
+            ++next_;
+        }
+
+        [[nodiscard]] size_t Count() const { return std::min<size_t>(next_, ring_size); }
+
+        // upper bound of the bucket holding the a_fraction quantile, in ticks; within 25% of the exact value
+        [[nodiscard]] uint64_t Quantile(const double a_fraction) const {
+            const auto count = Count();
+            if (count == 0) {
+                return 0;
+            }
+            const auto rank = static_cast<size_t>(a_fraction * static_cast<double>(count - 1)) + 1;
+            size_t seen = 0;
+            for (size_t i = 0; i < n_buckets; ++i) {
+                if (seen += buckets_[i]; seen >= rank) {
+                    return std::min(UpperBound(i), Max());
+                }
+            }
+            return Max();
+        }
+
+        [[nodiscard]] uint64_t Max() const {
+            uint32_t result = 0;
+            for (size_t i = 0; i < Count(); ++i) {
+                result = std::max(result, ring_[i]);
+            }
+            return result;
+        }
+
+        // oldest first
+        template <class F>
+        void ForEachSample(F&& a_func) const {
+            const auto count = Count();
+            for (size_t i = next_ - count; i < next_; ++i) {
+                a_func(ring_[i % ring_size]);
+            }
+        }
+
+    private:
+        std::array<uint32_t, ring_size> ring_{};
+        std::array<uint32_t, n_buckets> buckets_{};
+        size_t next_ = 0;
+
+        static size_t Bucket(const uint32_t a_ticks) {
+            const auto width = static_cast<size_t>(std::bit_width(a_ticks));
+            if (width <= sub_bits) {
+                return a_ticks;
+            }
+            const auto sub = a_ticks >> (width - 1 - sub_bits) & ((1u << sub_bits) - 1);
+            return (width - sub_bits) << sub_bits | sub;
+        }
+
+        static uint64_t UpperBound(const size_t a_bucket) {
+            if (a_bucket < (size_t{1} << sub_bits)) {
+                return a_bucket;
+            }
+            const auto width = (a_bucket >> sub_bits) + sub_bits;
+            const auto sub = a_bucket & ((1u << sub_bits) - 1);
+            const auto step = uint64_t{1} << (width - 1 - sub_bits);
+            return (uint64_t{1} << (width - 1)) + (sub + 1) * step - 1;
+        }
+    };
+
+    inline std::array<Histogram, static_cast<size_t>(Stage::kTotal)> histograms;
+
+    inline Histogram& Get(const Stage a_stage) { return histograms[static_cast<size_t>(a_stage)]; }
+
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(const Stage a_stage) : stage_(a_stage), start_(Ticks()) {}
+        ~ScopedTimer() { Get(stage_).Record(Ticks() - start_); }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Stage stage_;
+        uint64_t start_;
+    };
+
+    // every sample still in the rings, one row per sample, oldest first within a stage
+    inline bool DumpCSV(const std::filesystem::path& a_path) {
+        const auto ticks_per_micro = TicksPerMicro();
+        if (ticks_per_micro <= 0.0) {
+            return false;
+        }
+        std::ofstream file(a_path, std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << "stage,sample,microseconds\n";
+        for (size_t stage = 0; stage < histograms.size(); ++stage) {
+            size_t index = 0;
+            histograms[stage].ForEachSample([&](const uint32_t a_ticks) {
+                file << stage_names[stage] << ',' << index++ << ',' << static_cast<double>(a_ticks) / ticks_per_micro
+                    << '\n';
+            });
+        }
+        return true;
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <deque>
+#include <string>
+#include <string_view>
+#include "Utils.h"
+
+// Interned prompt texts. Mods send the same few strings ("Talk", "Take") over and over, so every distinct source text
+// is kept once, next to its translation, and buttons hold a counted 32-bit handle to it. Only the frame owner touches
+// the store. A text whose last reference goes away stays readable until the next Collect, so render records built
+// during a frame can point at it instead of copying it.
+namespace PromptText {
+    using Handle = uint32_t;
+    inline constexpr Handle none = 0;
+
+    class Store {
+        struct Entry {
+            std::string source;
+            std::string text; // source with embedded translation keys resolved
+            uint32_t refs = 0;
+            bool live = false;
+        };
+
+        // indexed by handle, slot 0 stays empty; a deque so entries, and the index's views into them, never move
+        std::deque<Entry> entries_{1};
+        Map<std::string_view, Handle> index_;
+        std::vector<Handle> free_;
+        // handles whose count reached zero since the last Collect; may repeat, or have been acquired again
+        std::vector<Handle> released_;
+        size_t live_ = 0;
+
+    public:
+        Handle Acquire(const std::string_view a_source) {
+            if (const auto it = index_.find(a_source); it != index_.end()) {
+                ++entries_[it->second].refs;
+                return it->second;
+            }
+            Handle handle;
+            if (!free_.empty()) {
+                handle = free_.back();
+                free_.pop_back();
+            } else {
+                handle = static_cast<Handle>(entries_.size());
+                entries_.emplace_back();
+            }
+            auto& entry = entries_[handle];
+            entry.source.assign(a_source);
+            entry.text = entry.source;
+            TranslateEmbedded(entry.text);
+            entry.refs = 1;
+            entry.live = true;
+            index_.emplace(entry.source, handle);
+            ++live_;
+            return handle;
+        }
+
+        void AddRef(const Handle a_handle) {
+            if (a_handle != none) {
+                ++entries_[a_handle].refs;
+            }
+        }
+
+        void Release(const Handle a_handle) {
+            if (a_handle != none && --entries_[a_handle].refs == 0) {
+                released_.push_back(a_handle);
+            }
+        }
+
+        // frees the texts that are still unreferenced; called at the start of a frame
+        void Collect() {
+            for (const auto handle : released_) {
+                auto& entry = entries_[handle];
+                if (entry.refs || !entry.live) {
+                    continue;
+                }
+                index_.erase(std::string_view(entry.source));
+                entry.source.clear();
+                entry.text.clear();
+                entry.live = false;
+                free_.push_back(handle);
+                --live_;
+            }
+            released_.clear();
+        }
+
+        [[nodiscard]] const std::string& Source(const Handle a_handle) const { return entries_[a_handle].source; }
+        [[nodiscard]] const std::string& Text(const Handle a_handle) const { return entries_[a_handle].text; }
+        [[nodiscard]] size_t Size() const { return live_; }
+    };
+
+    // Never destroyed: Refs live in the renderer's singletons, which may be torn down after any static the store
+    // could be, and their destructors still release into it.
+    inline Store& GetStore() {
+        static auto* const store = new Store();
+        return *store;
+    }
+
+    // a counted reference into the store; copies share the text
+    class Ref {
+        Handle handle_ = none;
+
+    public:
+        Ref() = default;
+        explicit Ref(const std::string_view a_source) : handle_(GetStore().Acquire(a_source)) {}
+        Ref(const Ref& a_other) : handle_(a_other.handle_) { GetStore().AddRef(handle_); }
+        Ref(Ref&& a_other) noexcept : handle_(std::exchange(a_other.handle_, none)) {}
+        Ref& operator=(Ref a_other) noexcept {
+            std::swap(handle_, a_other.handle_);
+            return *this;
+        }
+        ~Ref() { GetStore().Release(handle_); }
+
+        [[nodiscard]] Handle GetHandle() const { return handle_; }
+        [[nodiscard]] const std::string& Source() const { return GetStore().Source(handle_); }
+        [[nodiscard]] const std::string& Text() const { return GetStore().Text(handle_); }
+    };
+}
@@ -1,39 +1,67 @@
 #pragma once
 #include <shared_mutex>
+#include <thread>
 #include "imgui.h"
 #include "SkyPrompt/API.hpp"
 #include "Interaction.h"
 #include "MCP.h"
 #include "Theme.h"
 #include "ClibUtil/simpleINI.hpp"
-
+#include "MPSCQueue.h"
+#include "ClientSet.h"
+#include "IndexedHeap.h"
+#include "TimerWheel.h"
+#include "PressGesture.h"
+#include "PromptText.h"
+#include "Service.h"
+
+namespace IconFont {
+    struct IconTexture;
+}
 
 namespace ImGui::Renderer {
-    struct ButtonState;
+    using ButtonState = PressGesture::Machine;
 
     struct ButtonMutables {
-        std::string text;
         uint32_t text_color;
         float progress;
+        PromptText::Ref text;
     };
 
     constexpr float progress_circle_offset = 1.f / 12.f;
     constexpr float progress_circle_offset_deg = 360.f * progress_circle_offset * 0.5f;
 }
 
+// Fixed-size, and laid out hot to cold: what ShowQueue and the input path read every frame comes
+// first, the resolved-icon cache and the attached reference last.
 struct InteractionButton {
     using Mutables = ImGui::Renderer::ButtonMutables;
+    // prompt-specific key per device, 0 where the prompt uses its slot's default key
+    using Keys = std::array<uint32_t, Input::DEVICE::kTotal>;
+
     Interaction interaction;
-    mutable Mutables mutables;
     SkyPromptAPI::PromptType type = SkyPromptAPI::PromptType::kSinglePress;
-    RE::ObjectRefHandle attached_object;
-    std::map<Input::DEVICE, uint32_t> keys;
+    // kTimingOut already went out for the current lifetime; cleared whenever the lifetime restarts
+    bool timing_out_sent = false;
     int default_key_index = 0;
+    mutable Mutables mutables;
+    Keys keys{};
+
+    // key and icon as last resolved for each device; stale once MCP::Settings::bindings_version moves on
+    struct Resolved {
+        uint32_t version = 0;
+        uint32_t key = 0;
+        const IconFont::IconTexture* icon = nullptr;
+    };
 
-    [[nodiscard]] uint32_t GetKey() const;
+    mutable std::array<Resolved, Input::DEVICE::kTotal> resolved{};
+    RE::ObjectRefHandle attached_object;
+
+    [[nodiscard]] const Resolved& Resolve() const;
+    [[nodiscard]] uint32_t GetKey() const { return Resolve().key; }
 
     explicit InteractionButton(const Interaction& a_interaction, const Mutables& a_mutables,
-                               SkyPromptAPI::PromptType a_type, RefID a_refid, std::map<Input::DEVICE, uint32_t> a_keys,
+                               SkyPromptAPI::PromptType a_type, RefID a_refid, const Keys& a_keys,
                                int a_default_key_index);
     bool operator==(const InteractionButton& a_rhs) const { return interaction == a_rhs.interaction; }
     bool operator<(const InteractionButton& a_rhs) const { return interaction < a_rhs.interaction; }
@@ -41,24 +69,37 @@ struct InteractionButton {
 };
 
 struct ButtonQueue {
-    ButtonQueue() = default;
+    // a_clock is the queue clock (Manager::GetClock) the lifetime runs on; it has to outlive the queue
+    explicit ButtonQueue(const double& a_clock) : clock(&a_clock) {}
 
     float alpha;
     float lifetime = MCP::Settings::lifetime;
-    float elapsed = 0.0f;
-    [[nodiscard]] bool expired() const { return elapsed >= lifetime; }
+    const double* clock;
+    // *clock when the lifetime last restarted
+    double started = 0.0;
+    [[nodiscard]] double deadline() const { return started + lifetime; }
+    [[nodiscard]] bool expired() const;
     [[nodiscard]] bool IsHidden() const { return alpha <= 0.f; }
 
-    std::set<InteractionButton> buttons;
-    const InteractionButton* current_button = nullptr;
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    // sorted by Interaction; current_index always points into buttons or is npos
+    std::vector<InteractionButton> buttons;
+    size_t current_index = npos;
     void Clear();
     void Reset();
     void WakeUp();
-    void Show(float progress, const InteractionButton* button2show, const ImGui::Renderer::ButtonState& a_button_state);
-    const InteractionButton* AddButton(const InteractionButton& a_button);
+    void Restart();
+    void Show(float progress, size_t index2show, const ImGui::Renderer::ButtonState& a_button_state);
+    size_t AddButton(InteractionButton&& a_button);
     bool RemoveButton(const Interaction& a_interaction);
+    bool RemoveCurrent();
+    [[nodiscard]] size_t Find(const Interaction& a_interaction) const;
+    [[nodiscard]] const InteractionButton* GetCurrent() const {
+        return current_index < buttons.size() ? &buttons[current_index] : nullptr;
+    }
     [[nodiscard]] bool IsEmpty() const { return buttons.empty(); }
-    [[nodiscard]] const InteractionButton* Next() const;
+    [[nodiscard]] size_t Next() const;
     [[nodiscard]] size_t size() const { return buttons.size(); }
 };
 
@@ -78,41 +119,63 @@ namespace ImGui::Renderer {
     float GetResolutionScale();
     void RenderPrompts(); // starts here
 
-    struct ButtonState {
-        bool isPressing = false;
-        int pressCount = 0;
-        std::chrono::steady_clock::time_point lastPressTime;
-
-        void Reset() {
-            isPressing = false;
-            pressCount = 0;
-        }
-    };
+    // Game-side services the prompt queue depends on. The queue only talks to the game through these; the plugin
+    // implements them in Platform.cpp and the headless build in headless/platform.
+    namespace Platform {
+        float GetSecondsSinceLastFrame();
+        RE::ObjectRefHandle LookupRef(RefID a_refid);
+        const IconFont::IconTexture* LookupIcon(uint32_t a_key);
+        bool IsGameFrozen();
+        ImVec2 GetScreenSize();
+        ImVec2 GetAttachedObjectPos(RE::TESObjectREFR* a_ref);
+    }
 
+    // Only touched by whoever holds Manager's frame lock, which is the render thread while it renders. Input reaches
+    // it through Manager::PushInput and timed work through Manager::Defer, so none of its state needs its own lock.
     class SubManager {
-        mutable std::shared_mutex q_mutex_;
-        mutable std::shared_mutex progress_mutex_;
-        mutable std::shared_mutex sink_mutex_;
+        inline static std::atomic<uint64_t> next_id_{1};
+        const uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed);
+
         ButtonQueue interactQueue;
         float progress_circle = 0.0f;
         float progress_circle_max = 1.f;
 
-        std::atomic<bool> blockProgress = false;
+        bool blockProgress = false;
 
-        std::map<Interaction, std::vector<const SkyPromptAPI::PromptSink*>> sinks;
+        // the sinks behind each interaction, with where its prompts sit in the sink's submitted prompts so SendEvent
+        // can go straight to them; set by AddSink and refreshed by Update when the sink is resent. A sink may list
+        // the same event and action more than once, and every one of them gets the event: they all lie in
+        // [first, last], which is a single prompt in the usual case.
+        struct SinkEntry {
+            const SkyPromptAPI::PromptSink* sink;
+            size_t first;
+            size_t last;
+        };
 
-        mutable std::atomic<bool> wakeup_queued_{false};
+        static std::pair<size_t, size_t> SameAction(std::span<const SkyPromptAPI::Prompt> a_prompts, size_t a_index);
 
-        void ButtonStateActions();
-        void Show(const InteractionButton* button2show);
+        std::map<Interaction, std::vector<SinkEntry>> sinks;
+
+        bool wakeup_queued_ = false;
+
+        // kMove deltas collected since the last FlushMove, for themes with coalesce_move
+        std::optional<std::pair<Interaction, std::pair<float, float>>> pending_move_;
+
+        // set while the client drives the progress of the current prompt, which ButtonStateActions has to watch
+        mutable bool progress_hint_ = false;
+
+        void Show(size_t index2show);
 
     public:
-        SubManager() = default;
-        ~SubManager();
+        explicit SubManager(const double& a_clock) : interactQueue(a_clock) {}
+
+        // never reused, so queued input can tell a freed SubManager from a new one at the same address
+        [[nodiscard]] uint64_t GetId() const { return id_; }
 
         ButtonState buttonState;
 
-        void Add2Q(const InteractionButton& iButton, bool show = true);
+        void Add2Q(InteractionButton&& iButton, bool show = true);
+        void Press(bool a_pressed, bool a_down, bool a_up, PressGesture::Clock::time_point a_time);
         bool RemoveFromQ(const Interaction& a_interaction);
         void RemoveFromQ(const SkyPromptAPI::PromptSink* a_prompt_sink);
         void RemoveCurrentPrompt();
@@ -120,6 +183,10 @@ namespace ImGui::Renderer {
         void ShowQueue();
         void WakeUpQueue();
         void CleanUpQueue();
+        void ButtonStateActions();
+        [[nodiscard]] bool HasPendingActions() const;
+        [[nodiscard]] bool IsExpired() const;
+        [[nodiscard]] double GetDeadline() const;
         void ClearQueue();
         void ClearQueue(SkyPromptAPI::PromptEventType a_event_type);
         bool HasQueue() const;
@@ -132,33 +199,235 @@ namespace ImGui::Renderer {
         bool HasPrompt() const;
         bool IsHidden() const;
 
-        std::vector<Interaction> GetInteractions() const;
         Interaction GetCurrentInteraction() const;
-        std::vector<InteractionButton> GetButtons() const;
-        const InteractionButton* GetCurrentButton() const;
-        void AddSink(const Interaction& a_interaction, const SkyPromptAPI::PromptSink* a_sink);
-        std::map<Interaction, std::vector<const SkyPromptAPI::PromptSink*>> GetSinks() const { return sinks; }
+        float GetCurrentProgressOverride() const;
+        void AddSink(const Interaction& a_interaction, const SkyPromptAPI::PromptSink* a_sink,
+                     std::span<const SkyPromptAPI::Prompt> a_prompts, size_t a_index);
+        std::vector<const SkyPromptAPI::PromptSink*> GetSinks() const;
+        void ClearSinks();
         bool IsInQueue(const SkyPromptAPI::PromptSink* a_sink) const;
         bool IsInQueue(const Interaction& a_interaction) const;
+        bool HasEvent(SCENES::Event a_event) const;
+        void SetSlot(int a_slot);
         void SendEvent(const Interaction& a_interaction, SkyPromptAPI::PromptEventType event_type,
                        std::pair<float, float> delta = {0.f, 0.f}, float progress_override = 0.f);
+        void AccumulateMove(std::pair<float, float> a_delta);
+        void FlushMove();
 
         ImVec2 GetAttachedObjectPos() const;
         RE::TESObjectREFR* GetAttachedObject() const;
 
-        void Update(SkyPromptAPI::ClientID a_client_id, const SkyPromptAPI::PromptSink* a_prompt_sink) const;
+        void Update(SkyPromptAPI::ClientID a_client_id, const SkyPromptAPI::PromptSink* a_prompt_sink);
+    };
+
+    // A sink's prompts as they were when it was sent. The render thread only ever reads this copy, so a sink may
+    // change its prompts, or be freed, while the queue still holds them; texts and keys point into the copy itself.
+    struct SubmittedPrompts {
+        explicit SubmittedPrompts(std::span<const SkyPromptAPI::Prompt> a_prompts);
+        SubmittedPrompts(const SubmittedPrompts&) = delete;
+        SubmittedPrompts& operator=(const SubmittedPrompts&) = delete;
+
+        std::vector<SkyPromptAPI::Prompt> prompts;
+
+    private:
+        std::string texts_;
+        std::vector<std::pair<RE::INPUT_DEVICE, SkyPromptAPI::ButtonID>> keys_;
+    };
+
+    using SubmittedPtr = std::shared_ptr<const SubmittedPrompts>;
+
+    struct PromptCommand {
+        enum class Type : std::uint8_t {
+            kSend,
+            kResend,
+            kRemove,
+            kSetPriority
+        };
+
+        Type type = Type::kSend;
+        const SkyPromptAPI::PromptSink* sink = nullptr;
+        SkyPromptAPI::ClientID clientID = 0;
+        // kSend, kResend
+        SubmittedPtr prompts = nullptr;
+        // kSetPriority
+        int priority = 0;
+    };
+
+    // Input for the SubManagers, queued by other threads and applied by the frame owner
+    struct InputCommand {
+        enum class Type : std::uint8_t {
+            kButton,
+            kMove,
+            kCycle
+        };
+
+        Type type = Type::kButton;
+        SubManager* manager = nullptr;
+        uint64_t managerID = 0;
+        // kButton
+        bool pressed = false;
+        bool down = false;
+        bool up = false;
+        std::chrono::steady_clock::time_point time{};
+        // kMove
+        std::pair<float, float> delta{0.f, 0.f};
+        bool moving = false;
+        // kCycle
+        bool left = false;
+    };
+
+    // One game input event as routing sees it. The input hook fills it from an RE::InputEvent, a replay from a trace.
+    struct KeyInput {
+        enum class Type : std::uint8_t {
+            kButton,
+            kMove
+        };
+
+        Type type = Type::kButton;
+        // as Input::Manager::Convert returns it, or kMouseMove, kThumbstickMoveL or kThumbstickMoveR
+        uint32_t key = 0;
+        // kButton
+        bool pressed = false;
+        bool down = false;
+        bool up = false;
+        std::chrono::steady_clock::time_point time{};
+        // kMove
+        std::pair<float, float> delta{0.f, 0.f};
+    };
+
+    // What the input hook needs to know about the visible prompts, rebuilt by the render thread whenever the set of
+    // visible prompts changes.
+    struct PromptSnapshot {
+        struct Entry {
+            uint32_t key = 0;
+            SkyPromptAPI::PromptType type = SkyPromptAPI::PromptType::kSinglePress;
+            bool blocks_input = false;
+            SubManager* manager = nullptr;
+            uint64_t managerID = 0;
+
+            bool operator==(const Entry&) const = default;
+        };
+
+        // sorted by key, slot order within a key
+        std::vector<Entry> entries;
+        bool hidden = true;
+
+        void Insert(const Entry& a_entry);
+        void BuildTable();
+        [[nodiscard]] std::span<const Entry> Find(const uint32_t a_key) const {
+            if (table.empty() || a_key == 0) {
+                return {};
+            }
+            const auto mask = table.size() - 1;
+            for (auto i = Hash(a_key) & mask;; i = (i + 1) & mask) {
+                if (const auto& bucket = table[i]; bucket.key == a_key) {
+                    return {entries.data() + bucket.first, bucket.count};
+                } else if (bucket.key == 0) {
+                    return {};
+                }
+            }
+        }
+
+    private:
+        // open-addressed, linear probing, key 0 marks an empty bucket; at most half full. first and count are as wide
+        // as the key so no number of entries can wrap them.
+        struct Bucket {
+            uint32_t key = 0;
+            uint32_t first = 0;
+            uint32_t count = 0;
+        };
+
+        std::vector<Bucket> table;
+
+        static size_t Hash(const uint32_t a_key) { return a_key * 0x9E3779B1u >> 16; }
+    };
+
+    // Everything a frame could have to do. When none of it applies the draw hook skips the whole ImGui frame.
+    struct FrameDemand {
+        bool has_prompts = false;
+        bool pending_submissions = false;
+        bool pending_inputs = false;
+        bool pending_events = false;
+        bool deferred_due = false;
+        bool reload_lifetime = false;
+        bool reload_prompt_size = false;
+
+        [[nodiscard]] constexpr bool Idle() const {
+            return !(has_prompts || pending_submissions || pending_inputs || pending_events ||
+                     deferred_due || reload_lifetime || reload_prompt_size);
+        }
+    };
+
+    // A recursive_mutex that remembers its owner, so code that relies on the caller holding it can check.
+    class FrameMutex {
+    public:
+        void lock() {
+            mutex_.lock();
+            Acquired();
+        }
+
+        bool try_lock() {
+            if (!mutex_.try_lock()) {
+                return false;
+            }
+            Acquired();
+            return true;
+        }
+
+        void unlock() {
+            if (--depth_ == 0) {
+                owner_.store({}, std::memory_order_relaxed);
+            }
+            mutex_.unlock();
+        }
+
+        [[nodiscard]] bool HeldByCurrentThread() const {
+            return owner_.load(std::memory_order_relaxed) == std::this_thread::get_id();
+        }
+
+    private:
+        std::recursive_mutex mutex_;
+        std::atomic<std::thread::id> owner_{};
+        // only touched by the owner
+        uint32_t depth_ = 0;
+
+        void Acquired() {
+            owner_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+            ++depth_;
+        }
     };
 
     class Manager : public REX::Singleton<Manager> {
-        void ReArrange();
         bool IsInQueue(const Interaction& a_interaction) const;
 
-        std::shared_mutex events_to_send_mutex;
-        std::map<const SkyPromptAPI::PromptSink*, std::vector<SkyPromptAPI::PromptEvent>> events_to_send_;
+        // sink events: producers append to the back buffer, SendEvents swaps it out once per frame and delivers
+        // without holding the lock. Sinks withdrawn while a frame is being delivered are listed in dropped_sinks_.
+        // Events keep the copy their prompt points into alive until they are delivered.
+        struct PendingEvent {
+            const SkyPromptAPI::PromptSink* sink;
+            size_t seq;
+            SkyPromptAPI::PromptEvent event;
+            SubmittedPtr source;
+        };
+
+        std::mutex events_mutex_;
+        std::vector<PendingEvent> events_back_;
+        std::vector<PendingEvent> events_front_;
+        std::vector<const SkyPromptAPI::PromptSink*> dropped_sinks_;
+        std::atomic<uint32_t> drop_generation_{0};
+        // Sinks removed with RemovePrompt whose removal the render thread has not applied yet, counted per call; they
+        // get no events from the moment RemovePrompt is called. Guarded by events_mutex_.
+        Map<const SkyPromptAPI::PromptSink*, uint32_t> tombstones_;
+        // the sink SendEvents is calling into right now, and the thread doing it
+        std::atomic<const SkyPromptAPI::PromptSink*> delivering_{nullptr};
+        std::atomic<std::thread::id> delivery_thread_{};
+        Map<const SkyPromptAPI::PromptSink*, PromptEventBatchCallback> batch_callbacks_;
+        std::vector<SkyPromptAPI::PromptEvent> batch_scratch_;
+        bool IsDropped(const SkyPromptAPI::PromptSink* a_sink);
         SubManager* Add2Q(SkyPromptAPI::ClientID a_clientID, const Interaction& a_interaction,
                           const ButtonMutables& a_mutables,
                           SkyPromptAPI::PromptType a_type, RefID a_refid,
-                          const std::map<Input::DEVICE, uint32_t>& a_bttn_map, bool show = true);
+                          const InteractionButton::Keys& a_keys, double a_priority, bool show = true);
 
         bool SwitchToClientManager(SkyPromptAPI::ClientID client_id);
 
@@ -171,40 +440,194 @@ namespace ImGui::Renderer {
 
         std::map<SkyPromptAPI::ClientID, std::vector<std::unique_ptr<SubManager>>> client_managers;
 
+        // clients with at least one non-empty queue, active client included; guarded by mutex_
+        ClientSet pending_clients_;
+        void RefreshPending(SkyPromptAPI::ClientID a_clientID);
+
+        // position of the active client among the pending ones, for DrawCycleIndicators
+        struct CycleIndicator {
+            size_t version = std::numeric_limits<size_t>::max();
+            SkyPromptAPI::ClientID client = 0;
+            SkyPromptAPI::ClientID index = 0;
+            SkyPromptAPI::ClientID others = 0;
+        } cycle_indicator_;
+
+        // owner lookups for Add2Q; guarded by mutex_. Entries can go stale when buttons leave a SubManager, so hits
+        // are verified against the manager list before use.
+        Map<uint64_t, SubManager*> interaction_index_;
+        Map<SCENES::Event, SubManager*> event_index_;
+        void DropFromIndex(const SubManager* a_manager);
+
+        // Lifetimes, guarded by mutex_. clock_ only advances while prompts are drawn and the game is not frozen. Every
+        // active SubManager with a queue has a timer at its lifetime deadline; a timer is current only while armed_
+        // holds its id, so restarted lifetimes are handled when the old timer fires. Expired queues move to fading_ and
+        // are watched each frame until their fade-out ends.
+        static constexpr double ticks_per_second = 100.0;
+        double clock_ = 0.0;
+        TimerWheel<std::pair<SubManager*, uint64_t>> lifetimes_;
+        Map<const SubManager*, uint64_t> armed_;
+        uint64_t next_timer_id_ = 0;
+        std::vector<SubManager*> fading_;
+        // set when a queue may have emptied, so CleanUpQueue has to look for slots to release
+        std::atomic<bool> queues_dirty_{true};
+        void Arm(SubManager* a_manager);
+
+        // Slot scheduling, guarded by mutex_. When all of a client's slots are taken, a prompt either pushes out the
+        // slot with the lowest priority or waits in waiting_ until a slot frees up. Heap scores are the priority minus
+        // aging_per_second times the enqueue time, so prompts move up the longer they wait without re-sorting; the
+        // effective priority at time t is score + aging_per_second * t. Aging only orders the line: pushing out a
+        // prompt on screen takes a higher SetPriority, so equal prompts never take turns evicting each other.
+        static constexpr double aging_per_second = 0.1;
+        Map<SkyPromptAPI::ClientID, IndexedHeap<const SkyPromptAPI::PromptSink*, double>> waiting_;
+        // by client and sink, like registered_sinks_; only the render thread writes it
+        std::map<std::pair<SkyPromptAPI::ClientID, const SkyPromptAPI::PromptSink*>, int> priorities_;
+        // priority each slot was (last) filled with
+        Map<const SubManager*, double> slot_priorities_;
+        static double Now();
+        double PriorityOf(SkyPromptAPI::ClientID a_clientID, const SkyPromptAPI::PromptSink* a_sink) const;
+        void Park(SkyPromptAPI::ClientID a_clientID, const SkyPromptAPI::PromptSink* a_sink);
+        // A sink is shown whole or not at all: it needs one slot for each of its events that no slot holds yet, and
+        // Preempt frees that many slots below a_priority (or none). Whatever was showing there is evicted from every
+        // slot and returned in a_victims; the caller parks it once it is done picking.
+        size_t FreeSlots(const std::vector<std::unique_ptr<SubManager>>& a_list) const;
+        size_t SlotsNeeded(const std::vector<std::unique_ptr<SubManager>>& a_list, SkyPromptAPI::ClientID a_clientID,
+                           const SkyPromptAPI::PromptSink* a_sink) const;
+        bool Preempt(const std::vector<std::unique_ptr<SubManager>>& a_list, const SkyPromptAPI::PromptSink* a_sink,
+                     double a_priority, size_t a_count, std::vector<const SkyPromptAPI::PromptSink*>& a_victims);
+
         const std::vector<std::unique_ptr<SubManager>>* GetManagerList(SkyPromptAPI::ClientID a_clientID) const;
         std::vector<std::unique_ptr<SubManager>>* GetManagerList(SkyPromptAPI::ClientID a_clientID);
 
         void Clear(SkyPromptAPI::PromptEventType a_event_type);
 
+        // Held by the render thread for the whole of RenderPrompts, and by any other thread before it touches a
+        // SubManager. Recursive because sink callbacks run inside the frame and may call back into the API.
+        FrameMutex frame_mutex_;
+
+        // API calls are queued here and applied by the render thread, so callers never wait on the locks above
+        MPSCQueue<PromptCommand, 1024> submissions_;
+        void Push(const PromptCommand& a_command);
+
+        // what each queued sink last sent; only the frame owner touches it
+        Map<const SkyPromptAPI::PromptSink*, SubmittedPtr> submitted_;
+
+        MPSCQueue<InputCommand, 1024> inputs_;
+        // What did not fit in inputs_, applied right after it. Presses and releases are never dropped; moves and
+        // held-key repeats merge into the one before them. While it is in use, new input goes here too, to stay in
+        // order.
+        std::mutex overflow_mutex_;
+        std::vector<InputCommand> overflow_;
+        std::atomic<bool> overflowing_{false};
+        void ApplyInput(const InputCommand& a_command);
+
+        // Work due at a later frame, as a min-heap on (deadline, seq); only the frame owner touches it. seq keeps
+        // actions with the same deadline in the order they were deferred.
+        struct Deferred {
+            std::chrono::steady_clock::time_point deadline;
+            uint64_t seq;
+            std::function<void()> action;
+
+            // heap order, so the earliest deadline ends up at the front
+            bool operator<(const Deferred& a_other) const {
+                return std::tie(deadline, seq) > std::tie(a_other.deadline, a_other.seq);
+            }
+        };
+
+        std::vector<Deferred> deferred_;
+        uint64_t next_deferred_seq_ = 0;
+        // what the actions RunDeferred is running defer themselves, kept out of the heap until they are done
+        std::vector<Deferred> deferred_later_;
+        bool running_deferred_ = false;
+
+        // (client, sink) pairs that are queued or pending, so the API can answer without touching the queues
+        std::mutex registry_mutex_;
+        std::set<std::pair<SkyPromptAPI::ClientID, const SkyPromptAPI::PromptSink*>> registered_sinks_;
+        void Unregister(SkyPromptAPI::ClientID a_clientID, const std::vector<const SkyPromptAPI::PromptSink*>& a_sinks);
+
+        // double-buffered so readers never take a lock; writers fill the back buffer and swap it in.
+        // snapshot_mutex_ is always taken before mutex_, and the snapshot is emptied before any SubManager is freed.
+        // Readers pin the buffer they read in snapshot_readers_, and a writer only reuses a buffer nobody has pinned.
+        std::array<PromptSnapshot, 2> snapshots_;
+        std::atomic<const PromptSnapshot*> snapshot_{&snapshots_[0]};
+        std::array<std::atomic<uint32_t>, 2> snapshot_readers_{};
+        std::mutex snapshot_mutex_;
+        PromptSnapshot& BackSnapshot();
+
     public:
         static bool IsGameFrozen();
         static Interaction MakeInteraction(SkyPromptAPI::ClientID a_clientID, SkyPromptAPI::EventID a_event,
                                            SkyPromptAPI::ActionID a_action);
 
         bool Add2Q(const SkyPromptAPI::PromptSink* a_prompt_sink, SkyPromptAPI::ClientID a_clientID);
+        void AdmitWaiting();
+        // queued like Submit, so it never waits for the render thread and applies before a SendPrompt made after it
+        void SetPriority(const SkyPromptAPI::PromptSink* a_prompt_sink, SkyPromptAPI::ClientID a_clientID,
+                         int a_priority);
         bool IsInQueue(SkyPromptAPI::ClientID a_clientID, const SkyPromptAPI::PromptSink* a_prompt_sink,
                        bool wake_up = false);
         void RemoveFromQ(SkyPromptAPI::ClientID a_clientID, const SkyPromptAPI::PromptSink* a_prompt_sink);
+        // Neither waits for the render thread. Submit queues a copy of the sink's prompts; if they cannot be added,
+        // the sink gets kRemovedByMod for each of them. Once Withdraw returns the sink gets no more events and may be
+        // freed; the only wait is for a call into that same sink that SendEvents is making on another thread.
+        bool Submit(const SkyPromptAPI::PromptSink* a_prompt_sink, SkyPromptAPI::ClientID a_clientID);
+        void Withdraw(const SkyPromptAPI::PromptSink* a_prompt_sink, SkyPromptAPI::ClientID a_clientID);
+        size_t ProcessSubmissions();
+        [[nodiscard]] std::unique_lock<FrameMutex> LockFrame() { return std::unique_lock(frame_mutex_); }
+        void PushInput(const InputCommand& a_command);
+        // Queues a_input for the prompts in a_snapshot bound to its key, and a cycle if it is a free cycle key.
+        // Returns whether the game should not see it.
+        bool RouteInput(const PromptSnapshot& a_snapshot, const KeyInput& a_input);
+        size_t ProcessInputs();
+        void FlushMoves() const;
+        // runs a_action on the render thread, holding the frame lock, at the first frame after a_delay has passed
+        void Defer(std::chrono::milliseconds a_delay, std::function<void()> a_action);
+        size_t RunDeferred();
         [[nodiscard]] bool HasTask() const;
+        [[nodiscard]] FrameDemand GetFrameDemand();
         void Start();
         void Stop();
         void CleanUpQueue();
         void ShowQueue();
-        void ResetQueue() const;
+        void ResetQueue();
+        [[nodiscard]] double GetClock() const { return clock_; }
+        void MarkQueuesDirty() { queues_dirty_.store(true); }
         void WakeUpQueue() const;
         bool IsPaused() const { return isPaused.load(); }
-        bool IsHidden() const;
-        SubManager* GetSubManagerByKey(uint32_t a_prompt_key) const;
-        std::vector<uint32_t> GetPromptKeys() const;
-        std::vector<std::pair<SkyPromptAPI::PromptType, uint32_t>> GetPromptButtons() const;
+        // The published snapshot, pinned until the SnapshotRef goes away. Meant for short reads like one input
+        // event: the render thread waits for the pin before it refills that buffer, so a thread holding one never
+        // applies queued input itself (see PushInput).
+        class SnapshotRef {
+        public:
+            SnapshotRef(const SnapshotRef&) = delete;
+            SnapshotRef& operator=(const SnapshotRef&) = delete;
+            ~SnapshotRef();
+
+            const PromptSnapshot& operator*() const { return *snapshot_; }
+            const PromptSnapshot* operator->() const { return snapshot_; }
+
+        private:
+            friend class Manager;
+
+            SnapshotRef(const PromptSnapshot* a_snapshot, std::atomic<uint32_t>* a_readers);
+
+            const PromptSnapshot* snapshot_;
+            std::atomic<uint32_t>* readers_;
+        };
+
+        [[nodiscard]] SnapshotRef GetSnapshot();
+        void PublishSnapshot();
+        void ClearSnapshot();
 
-        void ForEachManager(const std::function<void(std::unique_ptr<SubManager>&)>& a_func);
+        // the prompts a_sink was last sent with, or null if it is not queued
+        [[nodiscard]] const SubmittedPtr& GetSubmitted(const SkyPromptAPI::PromptSink* a_sink) const;
         void AddEventToSend(const SkyPromptAPI::PromptSink* a_sink, const SkyPromptAPI::Prompt& a_prompt,
                             SkyPromptAPI::PromptEventType event_type,
-                            std::pair<float, float> a_delta);
+                            std::pair<float, float> a_delta, SubmittedPtr a_source);
         void SendEvents();
+        void SetBatchCallback(const SkyPromptAPI::PromptSink* a_sink, PromptEventBatchCallback a_callback);
 
         bool InitializeClient(SkyPromptAPI::ClientID a_clientID);
         bool CycleClient(bool a_left);
+        [[nodiscard]] bool CanCycle() const;
     };
 }
\ No newline at end of file
@@ -13,6 +13,19 @@ extern "C" DLLEXPORT void ProcessRemovePrompt(const SkyPromptAPI::PromptSink* a_
 extern "C" DLLEXPORT SkyPromptAPI::ClientID ProcessRequestClientID(int a_major = 1, int a_minor = 0);
 extern "C" DLLEXPORT bool ProcessRequestTheme(SkyPromptAPI::ClientID a_clientID, std::string_view theme_name);
 
+// Optional: receive all of a sink's events for a frame in one call instead of one ProcessEvent per event.
+// Pass nullptr to go back to ProcessEvent. Dropped automatically when the sink is removed with RemovePrompt.
+using PromptEventBatchCallback = void (*)(const SkyPromptAPI::PromptSink* a_sink,
+                                          const SkyPromptAPI::PromptEvent* a_events, std::size_t a_count);
+extern "C" DLLEXPORT bool ProcessSetEventBatchCallback(const SkyPromptAPI::PromptSink* a_sink,
+                                                       SkyPromptAPI::ClientID a_clientID,
+                                                       PromptEventBatchCallback a_callback);
+
+// Higher priority prompts win slots when a client has more prompts than slots; the default is 0.
+// Set it before SendPrompt. Cleared when the sink is removed with RemovePrompt or its prompts leave the screen.
+extern "C" DLLEXPORT bool ProcessSetPromptPriority(const SkyPromptAPI::PromptSink* a_sink,
+                                                   SkyPromptAPI::ClientID a_clientID, int a_priority);
+
 namespace Service {
     inline std::mutex mutex_;
     inline SkyPromptAPI::ClientID last_clientID = 0;
@@ -36,6 +36,7 @@ namespace Theme {
         Field<std::vector<bool>, rapidjson::Value> special_bools = {"special_bools", {}};
 
         Field<bool, rapidjson::Value> hide_in_menu = {"hide_in_menu", false};
+        Field<bool, rapidjson::Value> coalesce_move = {"coalesce_move", false};
 
         void load(rapidjson::Value& a_block) {
             boost::pfr::for_each_field(*this, [&](auto& field) {
@@ -81,6 +82,8 @@ namespace Theme {
         std::vector<uint8_t> special_bools;
 
         bool hide_in_menu = false;
+        // send at most one kMove per prompt per frame, with the deltas of that frame summed up
+        bool coalesce_move = false;
 
         Theme() = default;
         explicit Theme(const ThemeBlock& block);
@@ -0,0 +1,87 @@
+#pragma once
+#include <array>
+#include <vector>
+
+// Hierarchical timing wheel: three levels of 64 slots. Level 0 covers the next 64 ticks one slot per tick; each level
+// above covers 64 times more with coarser slots that are cascaded down as time reaches them. Scheduling is O(1) and
+// advancing only touches the slots that come due. Timers cannot be cancelled; callers tag entries and ignore stale
+// ones when they fire.
+template <class T>
+class TimerWheel {
+    static constexpr size_t bits = 6;
+    static constexpr uint64_t n_slots = 1 << bits;
+    static constexpr size_t n_levels = 3;
+    static constexpr uint64_t span = uint64_t{1} << (bits * n_levels);
+
+    struct Entry {
+        T value;
+        uint64_t tick;
+    };
+
+public:
+    [[nodiscard]] uint64_t Now() const { return now_; }
+    [[nodiscard]] bool Empty() const { return count_ == 0; }
+
+    // a tick that is not in the future fires on the next Advance
+    void Schedule(const T& a_value, const uint64_t a_tick) {
+        Insert({a_value, std::max(a_tick, now_ + 1)});
+        ++count_;
+    }
+
+    template <class F>
+    void Advance(const uint64_t a_to, F&& a_fire) {
+        while (now_ < a_to) {
+            if (count_ == 0) {
+                now_ = a_to;
+                return;
+            }
+            ++now_;
+            for (size_t level = n_levels - 1; level > 0; --level) {
+                if ((now_ & ((uint64_t{1} << (bits * level)) - 1)) == 0) {
+                    Cascade(level);
+                }
+            }
+            auto& slot = levels_[0][now_ & (n_slots - 1)];
+            if (slot.empty()) {
+                continue;
+            }
+            // fired callbacks may schedule again, never into this slot
+            due_.swap(slot);
+            count_ -= due_.size();
+            for (const auto& a_entry : due_) {
+                a_fire(a_entry.value);
+            }
+            due_.clear();
+        }
+    }
+
+private:
+    std::array<std::array<std::vector<Entry>, n_slots>, n_levels> levels_;
+    std::vector<Entry> due_;
+    uint64_t now_ = 0;
+    size_t count_ = 0;
+
+    void Insert(const Entry& a_entry) {
+        const auto delta = a_entry.tick - now_;
+        for (size_t level = 0; level < n_levels; ++level) {
+            if (delta < (uint64_t{1} << (bits * (level + 1)))) {
+                levels_[level][(a_entry.tick >> (bits * level)) & (n_slots - 1)].push_back(a_entry);
+                return;
+            }
+        }
+        // further out than the wheel reaches: park in the last top-level slot, it is re-sorted when cascaded
+        levels_[n_levels - 1][((now_ + span - 1) >> (bits * (n_levels - 1))) & (n_slots - 1)].push_back(a_entry);
+    }
+
+    void Cascade(const size_t a_level) {
+        auto& slot = levels_[a_level][(now_ >> (bits * a_level)) & (n_slots - 1)];
+        if (slot.empty()) {
+            return;
+        }
+        std::vector<Entry> entries;
+        entries.swap(slot);
+        for (const auto& a_entry : entries) {
+            Insert(a_entry);
+        }
+    }
+};
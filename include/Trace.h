@@ -0,0 +1,117 @@
+#pragma once
+#include <fstream>
+#include <mutex>
+#include "SkyPrompt/API.hpp"
+
+// Optional binary log of everything that drives the prompt queue: raw input events, frame deltas and API calls.
+// A file starts with a FileHeader, followed by records that are a Kind byte, the frame number and the record's
+// payload, all little-endian and unpadded. Nothing is written unless recording was started from the MCP.
+namespace Trace {
+    inline constexpr std::array<char, 4> magic = {'S', 'P', 'T', 'R'};
+    inline constexpr uint16_t version = 1;
+
+    enum class Kind : std::uint8_t {
+        kFrame,
+        kButton,
+        kMouseMove,
+        kThumbstick,
+        kSend,
+        kRemove
+    };
+
+#pragma pack(push, 1)
+    struct FileHeader {
+        std::array<char, 4> magic = Trace::magic;
+        uint16_t version = Trace::version;
+    };
+
+    struct RecordHeader {
+        Kind kind;
+        uint32_t frame;
+    };
+
+    // start of a RenderPrompts call
+    struct FrameRecord {
+        float seconds_since_last_frame;
+        uint64_t micros; // since recording started
+    };
+
+    // RE::ButtonEvent: down when value > 0 and held == 0, up when value == 0 and held > 0
+    struct ButtonRecord {
+        uint32_t id_code;
+        uint8_t device;
+        float value;
+        float held_down_secs;
+    };
+
+    struct MouseMoveRecord {
+        int32_t x;
+        int32_t y;
+    };
+
+    struct ThumbstickRecord {
+        uint8_t left;
+        float x;
+        float y;
+    };
+
+    // followed by prompt_count prompts, each a PromptRecord, its text and key_count KeyRecords; prompts past 65535 are
+    // left out
+    struct SendRecord {
+        uint64_t sink; // identifies the sink within one trace, nothing more
+        SkyPromptAPI::ClientID client;
+        uint16_t prompt_count;
+    };
+
+    struct PromptRecord {
+        uint32_t event;
+        uint32_t action;
+        uint8_t type;
+        uint32_t refid;
+        uint32_t text_color;
+        float progress;
+        uint16_t text_length;
+        uint8_t key_count;
+    };
+
+    struct KeyRecord {
+        uint8_t device;
+        uint32_t key;
+    };
+
+    struct RemoveRecord {
+        uint64_t sink;
+        SkyPromptAPI::ClientID client;
+    };
+#pragma pack(pop)
+
+    class Manager : public REX::Singleton<Manager> {
+    public:
+        bool Start(const std::filesystem::path& a_path);
+        void Stop();
+        [[nodiscard]] bool IsRecording() const { return recording_.load(std::memory_order_relaxed); }
+        [[nodiscard]] const std::filesystem::path& GetPath() const { return path_; }
+
+        void Frame(float a_seconds_since_last_frame);
+        void Input(const RE::InputEvent* a_event);
+        // a_prompts is the copy Submit queued, so the trace holds exactly what the render thread is given
+        void Send(const SkyPromptAPI::PromptSink* a_sink, SkyPromptAPI::ClientID a_clientID,
+                  std::span<const SkyPromptAPI::Prompt> a_prompts);
+        void Remove(const SkyPromptAPI::PromptSink* a_sink, SkyPromptAPI::ClientID a_clientID);
+
+    private:
+        std::atomic<bool> recording_{false};
+        std::mutex mutex_;
+        std::ofstream file_;
+        std::filesystem::path path_;
+        std::chrono::steady_clock::time_point started_;
+        uint32_t frame_ = 0;
+
+        // callers hold mutex_
+        template <class T>
+        void Write(const T& a_value) {
+            file_.write(reinterpret_cast<const char*>(&a_value), sizeof(T));
+        }
+        void Begin(Kind a_kind);
+    };
+}
@@ -5,6 +5,8 @@
 #include "Service.h"
 #include "Tutorial.h"
 #include "Styles.h"
+#include "Trace.h"
+#include "Profiler.h"
 #include "imgui_impl_dx11.h"
 #include "imgui_impl_win32.h"
 
@@ -79,8 +81,19 @@ void DrawHook::thunk(std::uint32_t a_timer) {
         return;
     }
 
-    Styles::GetSingleton()->OnStyleRefresh();
+    Profiler::ScopedTimer timer(Profiler::Stage::kDrawHook);
+    {
+        Profiler::ScopedTimer style_timer(Profiler::Stage::kStyleRefresh);
+        Styles::GetSingleton()->OnStyleRefresh();
+    }
+
+    // nothing on screen and nothing to deliver: leave ImGui alone this frame
+    if (MANAGER(ImGui::Renderer)->GetFrameDemand().Idle()) {
+        ++stats.skipped;
+        return;
+    }
 
+    const auto start = std::chrono::steady_clock::now();
     ImGui_ImplDX11_NewFrame();
     ImGui_ImplWin32_NewFrame();
     {
@@ -98,6 +111,9 @@ void DrawHook::thunk(std::uint32_t a_timer) {
     EndFrame();
     Render();
     ImGui_ImplDX11_RenderDrawData(GetDrawData());
+
+    ++stats.drawn;
+    stats.draw_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 }
 
 
@@ -131,7 +147,9 @@ void InputHook::thunk(RE::BSTEventSource<RE::InputEvent*>* a_dispatcher, RE::Inp
     auto last = *a_event;
     size_t length = 0;
 
+    const auto trace = MANAGER(Trace);
     for (auto current = *a_event; current; current = current->next) {
+        trace->Input(current);
         if (ProcessInput(current) || Tutorial::showing_tutorial.load()) {
             if (current != last) {
                 last->next = current->next;
@@ -155,84 +173,32 @@ void InputHook::thunk(RE::BSTEventSource<RE::InputEvent*>* a_dispatcher, RE::Inp
 }
 
 bool InputHook::ProcessInput(RE::InputEvent* event) {
-    bool block = false;
-
     const auto render_manager = MANAGER(ImGui::Renderer);
-    if (render_manager->IsPaused()) return block;
-    if (render_manager->IsHidden()) return block;
+    if (render_manager->IsPaused()) return false;
+    const auto snapshot = render_manager->GetSnapshot();
+    if (snapshot->hidden) return false;
 
     const auto input_manager = MANAGER(Input);
     input_manager->UpdateInputDevice(event);
 
+    KeyInput input;
     if (const auto button_event = event->AsButtonEvent()) {
-        const auto key = input_manager->Convert(button_event->GetIDCode(), button_event->GetDevice());
-        for (const auto prompt_buttons = render_manager->GetPromptButtons(); const auto& [prompt_type,prompt_key] :
-             prompt_buttons) {
-            if (prompt_key != 0 && prompt_key == key) {
-                if (PromptTypeFlags::GetBlocksInput(prompt_type)) {
-                    block = true;
-                }
-                const auto now = std::chrono::steady_clock::now();
-                if (const auto submanager = render_manager->GetSubManagerByKey(prompt_key)) {
-                    submanager->buttonState.isPressing = button_event->IsPressed();
-                    if (button_event->IsDown()) {
-                        submanager->buttonState.pressCount++;
-                        submanager->buttonState.lastPressTime = now;
-                        submanager->SendEvent(submanager->GetCurrentInteraction(),
-                                              SkyPromptAPI::PromptEventType::kDown);
-                    } else if (button_event->IsUp()) {
-                        submanager->SendEvent(submanager->GetCurrentInteraction(), SkyPromptAPI::PromptEventType::kUp);
-                    }
-                    if (submanager->buttonState.pressCount > 0 || !submanager->buttonState.isPressing) {
-                        submanager->UpdateProgressCircle(submanager->buttonState.isPressing);
-                    }
-                }
-            }
-        }
-
-        if (!block && button_event->IsDown()) {
-            const auto device = input_manager->GetInputDevice();
-            const bool is_L = key == MCP::Settings::cycle_L[device];
-            const bool is_R = key == MCP::Settings::cycle_R[device];
-            if (is_L || is_R) {
-                block = Manager::GetSingleton()->CycleClient(is_L);
-            }
-        }
+        input = {.type = KeyInput::Type::kButton,
+                 .key = input_manager->Convert(button_event->GetIDCode(), button_event->GetDevice()),
+                 .pressed = button_event->IsPressed(), .down = button_event->IsDown(), .up = button_event->IsUp(),
+                 .time = std::chrono::steady_clock::now()};
     } else if (const auto mouse_event = event->AsMouseMoveEvent()) {
-        constexpr auto key = SkyPromptAPI::kMouseMove;
-        for (const auto prompt_keys = render_manager->GetPromptButtons(); const auto& [prompt_type,prompt_key] :
-             prompt_keys) {
-            if (prompt_key != 0 && prompt_key == key) {
-                if (PromptTypeFlags::GetBlocksInput(prompt_type)) {
-                    block = true;
-                }
-                if (const auto submanager = render_manager->GetSubManagerByKey(prompt_key)) {
-                    submanager->SendEvent(submanager->GetCurrentInteraction(), SkyPromptAPI::PromptEventType::kMove,
-                                          {static_cast<float>(mouse_event->mouseInputX),
-                                           static_cast<float>(mouse_event->mouseInputY)});
-                    submanager->UpdateProgressCircle(mouse_event->mouseInputX != 0 || mouse_event->mouseInputY != 0);
-                }
-            }
-        }
+        input = {.type = KeyInput::Type::kMove, .key = SkyPromptAPI::kMouseMove,
+                 .delta = {static_cast<float>(mouse_event->mouseInputX),
+                           static_cast<float>(mouse_event->mouseInputY)}};
     } else if (const auto thumbstick_event = event->AsThumbstickEvent()) {
-        const auto key = thumbstick_event->IsLeft() ? SkyPromptAPI::kThumbstickMoveL : SkyPromptAPI::kThumbstickMoveR;
-        for (const auto prompt_keys = render_manager->GetPromptButtons(); const auto& [prompt_type,prompt_key] :
-             prompt_keys) {
-            if (prompt_key != 0 && prompt_key == key) {
-                if (PromptTypeFlags::GetBlocksInput(prompt_type)) {
-                    block = true;
-                }
-                if (const auto submanager = render_manager->GetSubManagerByKey(prompt_key)) {
-                    submanager->SendEvent(submanager->GetCurrentInteraction(), SkyPromptAPI::PromptEventType::kMove,
-                                          {thumbstick_event->xValue, thumbstick_event->yValue});
-                    submanager->
-                        UpdateProgressCircle(thumbstick_event->xValue != 0.f || thumbstick_event->yValue != 0.f);
-                }
-            }
-        }
+        input = {.type = KeyInput::Type::kMove,
+                 .key = thumbstick_event->IsLeft() ? SkyPromptAPI::kThumbstickMoveL : SkyPromptAPI::kThumbstickMoveR,
+                 .delta = {thumbstick_event->xValue, thumbstick_event->yValue}};
+    } else {
+        return false;
     }
-
-    return block;
+    return render_manager->RouteInput(*snapshot, input);
 }
 
 void ImGui::Renderer::InstallInputHook() {
@@ -1,5 +1,6 @@
 ﻿#include "IconsFonts.h"
 #include "Renderer.h"
+#include "Profiler.h"
 #include "imgui_internal.h"
 #include <imgui_impl_dx11.h>
 #include "SkyPrompt/AddOns.hpp"
@@ -67,6 +68,8 @@ namespace IconFont {
         stepperRight.Load();
         checkbox.Load();
         checkboxFilled.Load();
+
+        ++MCP::Settings::bindings_version;
     }
 
     bool Manager::ReloadFonts() {
@@ -610,7 +613,7 @@ namespace {
                 }
             }
 
-            const ImVec2 textSize = ImGui::CalcTextSize(ri.text.c_str());
+            const ImVec2 textSize = ImGui::CalcTextSize(ri.text);
 
             const float circle_radius = iconSz * 1.25f * 0.5f;
 
@@ -639,9 +642,9 @@ namespace {
                 IM_COL32(0, 0, 0, static_cast<int>(255 * Theme::last_theme->font_shadow)), ri.alpha);
 
             AddTextRotated(dl, font, fs, {textCenter.x + 2.5f, textCenter.y + 2.5f},
-                           shadow, ri.text.c_str(), nullptr, orient, true);
+                           shadow, ri.text, nullptr, orient, true);
             AddTextRotated(dl, font, fs, textCenter,
-                           color, ri.text.c_str(), nullptr, orient, true);
+                           color, ri.text, nullptr, orient, true);
         }
 
         dl->PopClipRect();
@@ -667,7 +670,7 @@ namespace {
 
         // Measure each item's width (circle + vertical-style text padding + text)
         for (auto& ri : batch) {
-            const ImVec2 textSize = ImGui::CalcTextSize(ri.text.c_str());
+            const ImVec2 textSize = ImGui::CalcTextSize(ri.text);
             const float circle_radius = circleDia * 0.5f;
             const float radius = iconSz * 0.5f;
             const float rowHeight = std::max(circleDia, textSize.y);
@@ -752,7 +755,7 @@ namespace {
             };
 
             const ImU32 color = ri.text_color ? ri.text_color : IM_COL32(255, 255, 255, 255);
-            AddTextWithShadow(dl, font, fs, textPos, color, ri.text.c_str());
+            AddTextWithShadow(dl, font, fs, textPos, color, ri.text);
 
             // Advance cursor for next item
             xCursor += dim.width + lineSpacingPx;
@@ -818,6 +821,7 @@ void ImGui::RenderSkyPrompt() {
     if (renderBatch.empty()) {
         return;
     }
+    Profiler::ScopedTimer timer(Profiler::Stage::kRenderSkyPrompt);
 
     const auto& curr_theme = Theme::last_theme;
     const auto prompt_alignment = curr_theme->prompt_alignment;
@@ -832,7 +836,7 @@ void ImGui::RenderSkyPrompt() {
         case Theme::PromptAlignment::kVertical:
             for (const auto& a_renderInfo : renderBatch) {
                 PushStyleVar(ImGuiStyleVar_Alpha, a_renderInfo.alpha);
-                ButtonIconWithCircularProgress(a_renderInfo.text.c_str(), a_renderInfo.text_color,
+                ButtonIconWithCircularProgress(a_renderInfo.text, a_renderInfo.text_color,
                                                a_renderInfo.texture, a_renderInfo.progress,
                                                a_renderInfo.button_state);
                 PopStyleVar();
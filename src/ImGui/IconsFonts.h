@@ -4,6 +4,7 @@
 #include <unordered_set>
 #include "Interaction.h"
 #include "MCP.h"
+#include "FrameArena.h"
 
 
 namespace IconFont {
@@ -216,7 +217,7 @@ namespace IconFont {
 
 namespace ImGui {
     struct RenderInfo {
-        std::string text;
+        const char* text; // owned by frameArena or the PromptText store, valid until the next RenderPrompts
         uint32_t text_color;
         const IconFont::IconTexture* texture;
         float progress;
@@ -231,6 +232,9 @@ namespace ImGui {
 
     void DrawCycleIndicators(SkyPromptAPI::ClientID curr_index, SkyPromptAPI::ClientID queue_size);
 
+    // per-frame scratch memory, rewound at the start of every RenderPrompts
+    inline FrameArena frameArena;
+
     inline std::vector<RenderInfo> renderBatch;
 
     void RenderSkyPrompt();
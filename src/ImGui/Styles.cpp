@@ -2,6 +2,7 @@
 #include "IconsFonts.h"
 #include "MCP.h"
 #include "Renderer.h"
+#include "Profiler.h"
 
 namespace ImGui {
     void Styles::OnStyleRefresh() const {
@@ -52,7 +53,12 @@ namespace ImGui {
         GetStyle() = style;
 
         static bool reloadAttempted = false;
-        if (!MANAGER(IconFont)->ReloadFonts()) {
+        bool reloaded;
+        {
+            Profiler::ScopedTimer timer(Profiler::Stage::kReloadFonts);
+            reloaded = MANAGER(IconFont)->ReloadFonts();
+        }
+        if (!reloaded) {
             if (!reloadAttempted) {
                 reloadAttempted = true;
                 Theme::ReLoadDefaultTheme();
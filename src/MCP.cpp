@@ -7,6 +7,8 @@
 #include "Settings.h"
 #include "Theme.h"
 #include "Tutorial.h"
+#include "Trace.h"
+#include "Profiler.h"
 #include "SKSEMCP/SKSEMenuFramework.hpp"
 
 static void HelpMarker(const char* desc) {
@@ -120,6 +122,20 @@ void __stdcall MCP::RenderLog() {
     MCP_API::SameLine();
     MCP_API::Checkbox("Error", &LogSettings::log_error);
 
+    // input/frame/API trace for reproducing reports; off unless switched on here
+    const auto trace = MANAGER(Trace);
+    if (bool recording = trace->IsRecording(); MCP_API::Checkbox("Record Trace", &recording)) {
+        if (recording) {
+            trace->Start(GetLogPath().replace_extension(".trace"));
+        } else {
+            trace->Stop();
+        }
+    }
+    if (trace->IsRecording()) {
+        MCP_API::SameLine();
+        MCP_API::Text(trace->GetPath().string().c_str());
+    }
+
     // if "Generate Log" button is pressed, read the log file
     if (MCP_API::Button("Generate Log")) logLines = ReadLogFile();
 
@@ -133,6 +149,38 @@ void __stdcall MCP::RenderLog() {
     }
 }
 
+void __stdcall MCP::RenderPerformance() {
+    const auto& frames = ImGui::Renderer::DrawHook::stats;
+    MCP_API::Text(std::format("Frames drawn: {} ({:.3f} ms avg), skipped while idle: {}", frames.drawn,
+                              frames.drawn ? frames.draw_seconds * 1000.0 / static_cast<double>(frames.drawn) : 0.0,
+                              frames.skipped).c_str());
+
+    const auto ticks_per_micro = Profiler::TicksPerMicro();
+    if (ticks_per_micro <= 0.0) {
+        return;
+    }
+    const auto to_micros = [ticks_per_micro](const uint64_t a_ticks) {
+        return static_cast<double>(a_ticks) / ticks_per_micro;
+    };
+
+    // last Histogram::ring_size samples of each stage, in microseconds
+    MCP_API::Text(std::format("{:<20}{:>10}{:>10}{:>10}{:>10}", "Stage", "Samples", "p50", "p99", "Max").c_str());
+    for (size_t i = 0; i < Profiler::histograms.size(); ++i) {
+        const auto& histogram = Profiler::histograms[i];
+        MCP_API::Text(std::format("{:<20}{:>10}{:>10.1f}{:>10.1f}{:>10.1f}", Profiler::stage_names[i],
+                                  histogram.Count(), to_micros(histogram.Quantile(0.5)),
+                                  to_micros(histogram.Quantile(0.99)), to_micros(histogram.Max())).c_str());
+    }
+
+    if (MCP_API::Button("Dump CSV")) {
+        if (const auto path = GetLogPath().replace_extension(".perf.csv"); Profiler::DumpCSV(path)) {
+            logger::info("Wrote frame timings to {}", path.string());
+        } else {
+            logger::error("Failed to write frame timings to {}", path.string());
+        }
+    }
+}
+
 void MCP::Register() {
     if (!SKSEMenuFramework::IsInstalled()) {
         return;
@@ -146,6 +194,7 @@ void MCP::Register() {
     SKSEMenuFramework::AddSectionItem("Settings", RenderSettings);
     SKSEMenuFramework::AddSectionItem("Controls", RenderControls);
     SKSEMenuFramework::AddSectionItem("Theme", RenderTheme);
+    SKSEMenuFramework::AddSectionItem("Performance", RenderPerformance);
     SKSEMenuFramework::AddSectionItem("Log", RenderLog);
 }
 
@@ -261,6 +310,7 @@ void MCP::Settings::LoadDefaultPromptKeys() {
         {Input::DEVICE::kGamepadDirectX, Input::Manager::Convert(GAMEPAD_DIRECTX::kRight, RE::INPUT_DEVICE::kGamepad)},
         {Input::DEVICE::kGamepadOrbis, Input::Manager::Convert(GAMEPAD_ORBIS::kRight, RE::INPUT_DEVICE::kGamepad)}
     };
+    ++bindings_version;
 }
 
 namespace {
@@ -564,6 +614,7 @@ void MCP::Settings::from_json() {
                 }
             }
         }
+        ++bindings_version;
     } else {
         logger::error("Failed to find keys in settings.json");
     }
@@ -660,7 +711,12 @@ void __stdcall MCP::RenderControls() {
         settingsChanged = true;
     }
 
-    if (settingsChanged || prompt_keys_before != Settings::prompt_keys) {
+    if (prompt_keys_before != Settings::prompt_keys) {
+        ++Settings::bindings_version;
+        settingsChanged = true;
+    }
+
+    if (settingsChanged) {
         Settings::to_json();
     }
 
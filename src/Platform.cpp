@@ -0,0 +1,173 @@
+#include "Renderer.h"
+#include "BoundingBox.hpp"
+#include "IconsFonts.h"
+
+
+using namespace ImGui::Renderer;
+
+float ImGui::Renderer::GetResolutionScale() {
+    static auto height = RE::BSGraphics::Renderer::GetScreenSize().height;
+    return DisplayTweaks::borderlessUpscale ? DisplayTweaks::resolutionScale : static_cast<float>(height) / 1080.0f;
+}
+
+float Platform::GetSecondsSinceLastFrame() {
+    return RE::GetSecondsSinceLastFrame() / (RE::BSTimer::QGlobalTimeMultiplier() + EPSILON);
+}
+
+RE::ObjectRefHandle Platform::LookupRef(const RefID a_refid) {
+    if (const auto a_ref = RE::TESForm::LookupByID<RE::TESObjectREFR>(a_refid)) {
+        return a_ref->GetHandle();
+    }
+    if (const auto temp = RE::Inventory3DManager::GetSingleton()->tempRef; temp && temp->GetFormID() == a_refid) {
+        return temp->GetHandle();
+    }
+    return {};
+}
+
+const IconFont::IconTexture* Platform::LookupIcon(const uint32_t a_key) {
+    const auto icon_manager = MANAGER(IconFont);
+    if (icon_manager->unavailable_keys.contains(a_key)) {
+        return nullptr;
+    }
+    const auto icon = icon_manager->GetIcon(a_key);
+    if (!icon) {
+        logger::error("Button icon not found for key {}", a_key);
+    } else if (!icon->srView.Get()) {
+        logger::error("Button icon texture not loaded for key {}", a_key);
+    } else {
+        return icon;
+    }
+    icon_manager->unavailable_keys.insert(a_key);
+    return nullptr;
+}
+
+bool Platform::IsGameFrozen() {
+    if (const auto main = RE::Main::GetSingleton()) {
+        if (main->freezeTime) return true;
+        if (!main->gameActive) return true;
+    } else return true;
+    if (RE::UI::GetSingleton()->GameIsPaused()) return true;
+    return false;
+}
+
+ImVec2 Platform::GetScreenSize() {
+    const auto [width, height] = RE::BSGraphics::Renderer::GetScreenSize();
+    return {static_cast<float>(width), static_cast<float>(height)};
+}
+
+namespace {
+    ImVec2 WorldToScreenLoc(const RE::NiPoint3 position) {
+        static uintptr_t g_worldToCamMatrix = RELOCATION_ID(519579, 406126).address(); // 2F4C910, 2FE75F0
+        static auto g_viewPort = (RE::NiRect<float>*)RELOCATION_ID(519618, 406160).address(); // 2F4DED0, 2FE8B98
+
+        ImVec2 screenLocOut;
+        const RE::NiPoint3 niWorldLoc(position.x, position.y, position.z);
+
+        float zVal;
+
+        RE::NiCamera::WorldPtToScreenPt3((float(*)[4])g_worldToCamMatrix, *g_viewPort, niWorldLoc, screenLocOut.x,
+                                         screenLocOut.y, zVal, 1e-5f);
+        const ImVec2 rect = ImGui::GetIO().DisplaySize;
+
+        screenLocOut.x = rect.x * screenLocOut.x;
+        screenLocOut.y = 1.0f - screenLocOut.y;
+        screenLocOut.y = rect.y * screenLocOut.y;
+
+        return screenLocOut;
+    }
+
+    ImVec2 WorldToScreenLoc(const RE::NiPoint3 position, const RE::NiPointer<RE::NiCamera>& a_cam) {
+        float z;
+        ImVec2 screenLocOut;
+        RE::NiCamera::WorldPtToScreenPt3(a_cam->GetRuntimeData().worldToCam, a_cam->GetRuntimeData2().port,
+                                         position, screenLocOut.x, screenLocOut.y, z, 1e-5f);
+        const ImVec2 rect = ImGui::GetIO().DisplaySize;
+        screenLocOut.x = rect.x * screenLocOut.x;
+        screenLocOut.y = 1.0f - screenLocOut.y;
+        screenLocOut.y = rect.y * screenLocOut.y;
+        return screenLocOut;
+    }
+
+    void OffsetRight(const RE::NiPoint3& a_pos, const RE::NiPoint3& a_cam_pos, RE::NiPoint3& a_out,
+                     const float a_offset) {
+        const auto diff = a_pos - a_cam_pos;
+        constexpr RE::NiPoint3 z_vec(0.f, 0.f, 1.f);
+        const auto right_vec = diff.UnitCross(z_vec);
+        a_out = a_pos + right_vec * a_offset;
+    }
+
+    constexpr float CLAMP_MAX_OVERSHOOT = -100;
+
+    void FastClampToScreen(ImVec2& point) {
+        const ImVec2 rect = ImGui::GetIO().DisplaySize;
+        if (point.x < 0.0) {
+            const float overshootX = abs(point.x);
+            if (overshootX > CLAMP_MAX_OVERSHOOT) point.x += overshootX - CLAMP_MAX_OVERSHOOT;
+        } else if (point.x > rect.x) {
+            const float overshootX = point.x - rect.x;
+            if (overshootX > CLAMP_MAX_OVERSHOOT) point.x -= overshootX - CLAMP_MAX_OVERSHOOT;
+        }
+
+        if (point.y < 0.0) {
+            const float overshootY = abs(point.y);
+            if (overshootY > CLAMP_MAX_OVERSHOOT) point.y += overshootY - CLAMP_MAX_OVERSHOOT;
+        } else if (point.y > rect.y) {
+            const float overshootY = point.y - rect.y;
+            if (overshootY > CLAMP_MAX_OVERSHOOT) point.y -= overshootY - CLAMP_MAX_OVERSHOOT;
+        }
+    }
+}
+
+ImVec2 Platform::GetAttachedObjectPos(RE::TESObjectREFR* a_ref) {
+    if (const auto ref = a_ref) {
+        constexpr float padding = 10.f;
+        RE::NiPoint3 pos;
+        ImVec2 pos2d;
+
+        if (const auto temp_ref = RE::Inventory3DManager::GetSingleton()->tempRef;
+            temp_ref && ref->GetFormID() == temp_ref->GetFormID()) {
+            if (const auto inv3dmngr = RE::Inventory3DManager::GetSingleton(); !inv3dmngr->GetRuntimeData().loadedModels
+                .empty()) {
+                if (const auto& model = inv3dmngr->GetRuntimeData().loadedModels.back().spModel) {
+                    OffsetRight(model->world.translate, RE::UI3DSceneManager::GetSingleton()->cachedCameraPos, pos,
+                                model->worldBound.radius);
+                    pos2d = WorldToScreenLoc(pos, RE::UI3DSceneManager::GetSingleton()->camera) + ImVec2{
+                                (Theme::last_theme->prompt_size + padding) * DisplayTweaks::resolutionScale, 0};
+                }
+            }
+        } else if (const auto a_head = [&]() -> RE::NiAVObject* {
+            if (const auto actor = ref->As<RE::Actor>()) {
+                if (const auto middle = actor->GetMiddleHighProcess()) {
+                    return middle->headNode;
+                }
+            }
+            return nullptr;
+        }()) {
+            constexpr float npc_head_size = 15.f;
+            const float objectScale = ref->GetScale();
+            const auto cameraPos = RE::PlayerCamera::GetSingleton()->GetRuntimeData2().pos;
+            const auto npc_head_pos = a_head->world.translate;
+            const auto diff = npc_head_pos - cameraPos;
+            constexpr RE::NiPoint3 z_vec(0.f, 0.f, 1.f);
+            const auto right_vec = diff.UnitCross(z_vec);
+            pos = npc_head_pos + right_vec * (npc_head_size * objectScale);
+            pos2d = WorldToScreenLoc(pos) + ImVec2{
+                        (Theme::last_theme->prompt_size + padding) * DisplayTweaks::resolutionScale, 0};
+        } else {
+            DirectX::BoundingOrientedBox bounding_box;
+            BoundingBox::GetOBB(ref, bounding_box, true);
+
+            const auto center = bounding_box.Center;
+
+            pos = RE::NiPoint3{center.x, center.y, center.z + bounding_box.Extents.z + 10.f};
+            pos2d = WorldToScreenLoc(pos);
+
+            pos2d += ImVec2{0.f, -(Theme::last_theme->prompt_size + padding) * DisplayTweaks::resolutionScale};
+        }
+
+        FastClampToScreen(pos2d);
+
+        return pos2d;
+    }
+    return {};
+}
@@ -1,25 +1,49 @@
-﻿#include "Renderer.h"
-#include "BoundingBox.hpp"
+﻿#include <cassert>
+#include "Renderer.h"
 #include "Hooks.h"
-#include "CLibUtilsQTR/Tasker.hpp"
 #include "IconsFonts.h"
 #include "Styles.h"
 #include "Utils.h"
 #include "Service.h"
 #include "Tutorial.h"
+#include "Trace.h"
+#include "Profiler.h"
 
 
 using namespace ImGui::Renderer;
 
-float ImGui::Renderer::GetResolutionScale() {
-    static auto height = RE::BSGraphics::Renderer::GetScreenSize().height;
-    return DisplayTweaks::borderlessUpscale ? DisplayTweaks::resolutionScale : static_cast<float>(height) / 1080.0f;
-}
-
 void ImGui::Renderer::RenderPrompts() {
+    frameArena.Reset();
+    MANAGER(Trace)->Frame(Platform::GetSecondsSinceLastFrame());
     const auto manager = MANAGER(ImGui::Renderer);
-    manager->SendEvents();
-    manager->CleanUpQueue();
+    const auto frame = manager->LockFrame();
+    PromptText::GetStore().Collect();
+    using Profiler::Stage;
+    {
+        Profiler::ScopedTimer timer(Stage::kSubmissions);
+        manager->ProcessSubmissions();
+    }
+    {
+        Profiler::ScopedTimer timer(Stage::kInputs);
+        manager->ProcessInputs();
+        manager->FlushMoves();
+    }
+    {
+        Profiler::ScopedTimer timer(Stage::kDeferred);
+        manager->RunDeferred();
+    }
+    {
+        Profiler::ScopedTimer timer(Stage::kSendEvents);
+        manager->SendEvents();
+    }
+    {
+        Profiler::ScopedTimer timer(Stage::kCleanUpQueue);
+        manager->CleanUpQueue();
+    }
+    {
+        Profiler::ScopedTimer timer(Stage::kAdmitWaiting);
+        manager->AdmitWaiting();
+    }
 
     if (MCP::Settings::shouldReloadLifetime.exchange(false)) {
         manager->ResetQueue();
@@ -35,21 +59,21 @@ void ImGui::Renderer::RenderPrompts() {
         manager->Start();
     }
     if (!manager->HasTask()) {
+        manager->ClearSnapshot();
         return;
     }
 
-    manager->ShowQueue();
+    {
+        Profiler::ScopedTimer timer(Stage::kShowQueue);
+        manager->ShowQueue();
+    }
+    manager->PublishSnapshot();
 }
 
 
 namespace {
-    float ButtonStateToFloat(const ButtonState& a_button_state) {
-        auto a_press_count = a_button_state.pressCount;
-        if (a_button_state.isPressing && a_button_state.pressCount < 3) {
-            a_press_count--;
-        }
-        return static_cast<float>(a_press_count) + 0.1f;
-    }
+    // snapshots pinned by this thread
+    thread_local uint32_t snapshot_pins = 0;
 
     std::pair<int, float> splitFloat(const float x) {
         float int_part_f;
@@ -57,10 +81,6 @@ namespace {
         int int_part = static_cast<int>(std::abs(int_part_f)); // always positive
         return {int_part, frac_part}; // frac_part keeps original sign
     }
-
-    float GetSecondsSinceLastFrame() {
-        return RE::GetSecondsSinceLastFrame() / (RE::BSTimer::QGlobalTimeMultiplier() + EPSILON);
-    }
 }
 
 float InteractionButton::GetProgressOverride(const bool increment) const {
@@ -75,7 +95,7 @@ float InteractionButton::GetProgressOverride(const bool increment) const {
 
     if (mult == 0) return prog;
 
-    if (const auto new_frac = prog - mult * 0.1f * GetSecondsSinceLastFrame();
+    if (const auto new_frac = prog - mult * 0.1f * Platform::GetSecondsSinceLastFrame();
         new_frac < -1.f || std::signbit(new_frac) != std::signbit(prog)) {
         mutables.progress = static_cast<float>(mult);
     } else {
@@ -85,57 +105,52 @@ float InteractionButton::GetProgressOverride(const bool increment) const {
 }
 
 void ButtonQueue::Clear() {
-    current_button = nullptr;
+    current_index = npos;
     buttons.clear();
     Reset();
 }
 
 void ButtonQueue::Reset() {
-    lifetime = MCP::Settings::lifetime;
     alpha = 0.0f; // Reset alpha to start fade-in
-    elapsed = 0.0f;
+    Restart();
 }
 
 void ButtonQueue::WakeUp() {
     // wake up all buttons
-    lifetime = MCP::Settings::lifetime;
     alpha = 1.0f;
-    elapsed = 0.0f;
+    Restart();
 }
 
-void ButtonQueue::Show(float progress, const InteractionButton* button2show, const ButtonState& a_button_state) {
-    if (button2show) {
+void ButtonQueue::Restart() {
+    lifetime = MCP::Settings::lifetime;
+    started = *clock;
+    for (auto& a_button : buttons) {
+        a_button.timing_out_sent = false;
+    }
+}
+
+bool ButtonQueue::expired() const {
+    return *clock >= deadline();
+}
+
+void ButtonQueue::Show(float progress, const size_t index2show, const ButtonState& a_button_state) {
+    if (index2show != npos) {
         Reset();
-        current_button = button2show;
+        current_index = index2show;
         return;
     }
+    const auto current_button = GetCurrent();
     if (!current_button) {
-        current_button = Next();
+        current_index = Next();
         return;
     }
 
-    const auto seconds = GetSecondsSinceLastFrame();
+    const auto seconds = Platform::GetSecondsSinceLastFrame();
     if (expired()/* && current_button->alpha>0.f*/) {
         alpha = std::max(alpha - Theme::last_theme->fadeSpeed * seconds * 120.f, 0.0f);
     } else {
         alpha = std::min(alpha + Theme::last_theme->fadeSpeed * seconds * 120.f, 1.0f);
     }
-    if (Tutorial::showing_tutorial.load() || !Manager::IsGameFrozen()) {
-        elapsed += seconds;
-    }
-
-    std::string extra_text;
-    if (const auto total = buttons.size(); total > 1) {
-        if (const auto it = buttons.find(*current_button); it != buttons.end()) {
-            const auto index = std::distance(buttons.begin(), it) + 1;
-            extra_text = fmt::format(" ({}/{})", index, total);
-        } else {
-            logger::error("Current button not found in the queue");
-            current_button = Next();
-            if (!current_button) return;
-        }
-    }
-
     const auto button_type = current_button->type;
     const bool has_progress = PromptTypeFlags::GetHasProgress(button_type);
     if (const auto progress_override = current_button->GetProgressOverride(true); progress_override > EPSILON) {
@@ -143,153 +158,102 @@ void ButtonQueue::Show(float progress, const InteractionButton* button2show, con
         WakeUp();
     }
 
-    auto button_state = has_progress ? ButtonStateToFloat(a_button_state) : -1.f;
-
-    const auto buttonKey = current_button->GetKey();
-    const auto icon_manager = MANAGER(IconFont);
-    if (icon_manager->unavailable_keys.contains(buttonKey)) return;
-    const std::string base_text = current_button->mutables.text; // Cache the base text
-    std::string a_text;
-    a_text.reserve(base_text.size() + 1 + extra_text.size()); // Reserve memory to avoid reallocations
-    a_text.append(base_text);
-    if (!extra_text.empty()) {
-        // If extra_text is not empty
-        a_text.append(" ").append(extra_text);
-    }
-
-    const IconFont::IconTexture* buttonIcon = icon_manager->GetIcon(buttonKey);
-    if (!buttonIcon) {
-        logger::error("Button icon not found for key {}", buttonKey);
-        icon_manager->unavailable_keys.insert(buttonKey);
-        return;
-    }
+    auto button_state = has_progress ? a_button_state.Display() : -1.f;
 
-    if (buttonIcon->srView.Get()) {
-        ImGui::renderBatch.emplace_back(a_text.c_str(), current_button->mutables.text_color, buttonIcon, progress,
-                                        button_state, alpha, current_button->interaction.event);
+    const auto buttonIcon = current_button->Resolve().icon;
+    if (!buttonIcon) return;
+    const auto& base_text = current_button->mutables.text.Text();
+    const char* a_text;
+    if (const auto total = buttons.size(); total > 1) {
+        a_text = ImGui::frameArena.Format("{}  ({}/{})", base_text, current_index + 1, total);
     } else {
-        logger::error("Button icon texture not loaded for key {}", buttonKey);
-        icon_manager->unavailable_keys.insert(buttonKey);
+        // the store keeps released texts until the next frame starts, so no copy is needed
+        a_text = base_text.c_str();
     }
+
+    ImGui::renderBatch.emplace_back(a_text, current_button->mutables.text_color, buttonIcon, progress,
+                                    button_state, alpha, current_button->interaction.event);
 }
 
 
-const InteractionButton* ButtonQueue::AddButton(const InteractionButton& a_button) {
+size_t ButtonQueue::AddButton(InteractionButton&& a_button) {
+    const auto it = std::lower_bound(buttons.begin(), buttons.end(), a_button);
     // check if the button already exists
-    if (const auto it = buttons.find(a_button); it != buttons.end()) {
-        return nullptr;
+    if (it != buttons.end() && *it == a_button) {
+        return npos;
     }
-    // add the button
-    if (const auto [fst, snd] = buttons.insert(a_button); snd) {
-        return &*fst;
+    const auto index = static_cast<size_t>(std::distance(buttons.begin(), it));
+    buttons.insert(it, std::move(a_button));
+    // keep pointing at the same button
+    if (current_index != npos && index <= current_index) {
+        ++current_index;
     }
-    return nullptr;
+    return index;
 }
 
 bool ButtonQueue::RemoveButton(const Interaction& a_interaction) {
-    if (current_button && current_button->interaction == a_interaction) {
-        buttons.erase(*current_button);
-    }
-    // otherwise we need to find it in the Q.
-    else {
-        const auto it = std::ranges::find_if(buttons,
-                                             [&](const auto& btn) { return btn.interaction == a_interaction; });
-        if (it == buttons.end()) {
-            return false;
-        }
-        buttons.erase(it);
+    const auto index = current_index < buttons.size() && buttons[current_index].interaction == a_interaction
+                           ? current_index
+                           : Find(a_interaction);
+    if (index == npos) {
+        return false;
     }
-    current_button = nullptr;
+    buttons.erase(buttons.begin() + static_cast<std::ptrdiff_t>(index));
+    current_index = npos;
     Reset();
     return true;
 }
 
-const InteractionButton* ButtonQueue::Next() const {
-    if (current_button) {
-        if (auto it = buttons.find(*current_button); it != buttons.end()) {
-            ++it;
-            if (it != buttons.end()) {
-                return &*it;
-            }
-            return &*buttons.begin();
-        }
-    } else if (!buttons.empty()) {
-        return &*buttons.begin();
+bool ButtonQueue::RemoveCurrent() {
+    const auto index = current_index;
+    if (index >= buttons.size()) {
+        return false;
     }
-    return nullptr;
+    buttons.erase(buttons.begin() + static_cast<std::ptrdiff_t>(index));
+    Reset();
+    // the successor slides into the removed slot
+    current_index = buttons.empty() ? npos : index % buttons.size();
+    return true;
 }
 
-void Manager::ReArrange() {
-    std::map<SCENES::Event, std::vector<InteractionButton>> interactions;
-    std::map<Interaction, std::vector<const SkyPromptAPI::PromptSink*>> sinks;
-    SkyPromptAPI::ClientID a_clientID;
-
-    {
-        std::shared_lock lock(mutex_);
-        a_clientID = last_clientID;
-        for (const auto& a_manager : managers) {
-            for (const auto& interaction_button : a_manager->GetButtons()) {
-                auto& interaction = interaction_button.interaction;
-                for (auto i = Input::DEVICE::kKeyboardMouse; i < Input::DEVICE::kTotal;
-                     i = static_cast<Input::DEVICE>(static_cast<int>(i) + 1)) {
-                }
-                interactions[interaction.event].push_back(interaction_button);
-            }
-
-            for (const auto& [interaction, a_sinks] : a_manager->GetSinks()) {
-                if (const auto it = sinks.find(interaction); it != sinks.end()) {
-                    it->second.insert(it->second.end(), a_sinks.begin(), a_sinks.end());
-                } else {
-                    sinks[interaction] = a_sinks;
-                }
-            }
-        }
-    }
-
-    {
-        std::unique_lock lock(mutex_);
-        managers.clear();
+size_t ButtonQueue::Find(const Interaction& a_interaction) const {
+    const auto it = std::lower_bound(buttons.begin(), buttons.end(), a_interaction,
+                                     [](const InteractionButton& a_button, const Interaction& a_value) {
+                                         return a_button.interaction < a_value;
+                                     });
+    if (it == buttons.end() || !(it->interaction == a_interaction)) {
+        return npos;
     }
+    return static_cast<size_t>(std::distance(buttons.begin(), it));
+}
 
-    // distribute the interactions to the managers
-    for (const auto& interaction_buttons : interactions | std::views::values) {
-        for (const auto& interaction_button : interaction_buttons) {
-            const auto a_ref = interaction_button.attached_object.get().get();
-            const auto a_refid = a_ref ? a_ref->GetFormID() : 0;
-            if (!Add2Q(a_clientID, interaction_button.interaction, interaction_button.mutables, interaction_button.type,
-                       a_refid, interaction_button.keys, true)) {
-                logger::error("Failed to add interaction to the queue");
-            }
-        }
+size_t ButtonQueue::Next() const {
+    if (buttons.empty()) {
+        return npos;
     }
-
-    // distribute the sinks to the managers
-    {
-        std::unique_lock lock(mutex_);
-        for (const auto& a_manager : managers) {
-            for (const auto& [interaction, a_sinks] : sinks) {
-                if (a_manager->IsInQueue(interaction)) {
-                    for (const auto& a_sink : a_sinks) {
-                        a_manager->AddSink(interaction, a_sink);
-                    }
-                }
-            }
-        }
+    if (current_index >= buttons.size()) {
+        return 0;
     }
+    return (current_index + 1) % buttons.size();
 }
 
 bool Manager::IsInQueue(const Interaction& a_interaction) const {
     std::shared_lock lock(mutex_);
-    for (const auto& a_manager : managers) {
-        if (a_manager->HasQueue()) {
-            for (const auto& interaction : a_manager->GetInteractions()) {
-                if (interaction == a_interaction) {
-                    return true;
-                }
-            }
-        }
+    const auto it = interaction_index_.find(a_interaction.Key());
+    if (it == interaction_index_.end()) {
+        return false;
     }
-    return false;
+    const auto a_manager = it->second;
+    return std::ranges::any_of(managers, [a_manager](const auto& m) { return m.get() == a_manager; }) &&
+           a_manager->IsInQueue(a_interaction);
+}
+
+void Manager::DropFromIndex(const SubManager* a_manager) {
+    std::erase_if(interaction_index_, [a_manager](const auto& a_entry) { return a_entry.second == a_manager; });
+    std::erase_if(event_index_, [a_manager](const auto& a_entry) { return a_entry.second == a_manager; });
+    slot_priorities_.erase(a_manager);
+    armed_.erase(a_manager);
+    std::erase(fading_, a_manager);
 }
 
 const std::vector<std::unique_ptr<SubManager>>* Manager::GetManagerList(const SkyPromptAPI::ClientID a_clientID) const {
@@ -331,12 +295,7 @@ bool Manager::InitializeClient(const SkyPromptAPI::ClientID a_clientID) {
 }
 
 bool Manager::IsGameFrozen() {
-    if (const auto main = RE::Main::GetSingleton()) {
-        if (main->freezeTime) return true;
-        if (!main->gameActive) return true;
-    } else return true;
-    if (RE::UI::GetSingleton()->GameIsPaused()) return true;
-    return false;
+    return Platform::IsGameFrozen();
 }
 
 void SubManager::SendEvent(const Interaction& a_interaction, const SkyPromptAPI::PromptEventType event_type,
@@ -344,210 +303,152 @@ void SubManager::SendEvent(const Interaction& a_interaction, const SkyPromptAPI:
     constexpr uint32_t a_max = std::numeric_limits<SkyPromptAPI::ClientID>::max();
     const SkyPromptAPI::EventID a_event = a_interaction.event % a_max;
     const SkyPromptAPI::ActionID a_action = a_interaction.action % a_max;
-    std::shared_lock lock(sink_mutex_);
+    const auto matches = [a_event, a_action](const SkyPromptAPI::Prompt& a_prompt) {
+        return a_prompt.eventID == a_event && a_prompt.actionID == a_action;
+    };
+    const auto manager = Manager::GetSingleton();
     if (const auto it = sinks.find(a_interaction); it != sinks.end()) {
-        for (const auto& a_sink : it->second) {
-            if (!a_sink) continue;
-            for (const auto prompts = a_sink->GetPrompts(); const auto& prompt : prompts) {
-                if (prompt.eventID == a_event && prompt.actionID == a_action) {
-                    SkyPromptAPI::Prompt a_prompt = prompt;
-                    if (std::abs(progress_override) > 0.f) {
-                        a_prompt.progress = progress_override;
-                    }
-                    Manager::GetSingleton()->AddEventToSend(a_sink, a_prompt, event_type, delta);
+        for (auto& [a_sink, first, last] : it->second) {
+            const auto& submitted = manager->GetSubmitted(a_sink);
+            if (!submitted) continue;
+            const std::span<const SkyPromptAPI::Prompt> prompts = submitted->prompts;
+            if (last >= prompts.size() || !matches(prompts[first])) {
+                // the sink changed its prompts without resending them
+                const auto found = std::ranges::find_if(prompts, matches);
+                if (found == prompts.end()) {
+                    continue;
+                }
+                std::tie(first, last) = SameAction(prompts, static_cast<size_t>(found - prompts.begin()));
+            }
+            for (size_t index = first; index <= last; ++index) {
+                if (!matches(prompts[index])) {
+                    continue;
+                }
+                SkyPromptAPI::Prompt a_prompt = prompts[index];
+                if (std::abs(progress_override) > 0.f) {
+                    a_prompt.progress = progress_override;
                 }
+                manager->AddEventToSend(a_sink, a_prompt, event_type, delta, submitted);
             }
         }
     }
 }
 
-namespace {
-    ImVec2 WorldToScreenLoc(const RE::NiPoint3 position) {
-        static uintptr_t g_worldToCamMatrix = RELOCATION_ID(519579, 406126).address(); // 2F4C910, 2FE75F0
-        static auto g_viewPort = (RE::NiRect<float>*)RELOCATION_ID(519618, 406160).address(); // 2F4DED0, 2FE8B98
-
-        ImVec2 screenLocOut;
-        const RE::NiPoint3 niWorldLoc(position.x, position.y, position.z);
-
-        float zVal;
-
-        RE::NiCamera::WorldPtToScreenPt3((float(*)[4])g_worldToCamMatrix, *g_viewPort, niWorldLoc, screenLocOut.x,
-                                         screenLocOut.y, zVal, 1e-5f);
-        const ImVec2 rect = ImGui::GetIO().DisplaySize;
-
-        screenLocOut.x = rect.x * screenLocOut.x;
-        screenLocOut.y = 1.0f - screenLocOut.y;
-        screenLocOut.y = rect.y * screenLocOut.y;
-
-        return screenLocOut;
-    }
+std::pair<size_t, size_t> SubManager::SameAction(const std::span<const SkyPromptAPI::Prompt> a_prompts,
+                                                 const size_t a_index) {
+    const auto& prompt = a_prompts[a_index];
+    const auto matches = [&prompt](const SkyPromptAPI::Prompt& a_prompt) {
+        return a_prompt.eventID == prompt.eventID && a_prompt.actionID == prompt.actionID;
+    };
+    const auto first = static_cast<size_t>(std::ranges::find_if(a_prompts, matches) - a_prompts.begin());
+    const auto last = a_prompts.size() - 1 -
+                      static_cast<size_t>(std::ranges::find_if(a_prompts | std::views::reverse, matches) -
+                                          (a_prompts | std::views::reverse).begin());
+    return {first, last};
+}
 
-    ImVec2 WorldToScreenLoc(const RE::NiPoint3 position, const RE::NiPointer<RE::NiCamera>& a_cam) {
-        float z;
-        ImVec2 screenLocOut;
-        RE::NiCamera::WorldPtToScreenPt3(a_cam->GetRuntimeData().worldToCam, a_cam->GetRuntimeData2().port,
-                                         position, screenLocOut.x, screenLocOut.y, z, 1e-5f);
-        const ImVec2 rect = ImGui::GetIO().DisplaySize;
-        screenLocOut.x = rect.x * screenLocOut.x;
-        screenLocOut.y = 1.0f - screenLocOut.y;
-        screenLocOut.y = rect.y * screenLocOut.y;
-        return screenLocOut;
+void SubManager::AccumulateMove(const std::pair<float, float> a_delta) {
+    const auto interaction = GetCurrentInteraction();
+    if (pending_move_ && pending_move_->first == interaction) {
+        pending_move_->second.first += a_delta.first;
+        pending_move_->second.second += a_delta.second;
+        return;
     }
-
-    void OffsetRight(const RE::NiPoint3& a_pos, const RE::NiPoint3& a_cam_pos, RE::NiPoint3& a_out,
-                     const float a_offset) {
-        const auto diff = a_pos - a_cam_pos;
-        constexpr RE::NiPoint3 z_vec(0.f, 0.f, 1.f);
-        const auto right_vec = diff.UnitCross(z_vec);
-        a_out = a_pos + right_vec * a_offset;
+    // the prompt changed mid-frame, the old one still gets what it had collected
+    if (const auto previous = std::exchange(pending_move_, std::make_pair(interaction, a_delta))) {
+        SendEvent(previous->first, SkyPromptAPI::PromptEventType::kMove, previous->second);
     }
+}
 
-    constexpr float CLAMP_MAX_OVERSHOOT = -100;
-
-    void FastClampToScreen(ImVec2& point) {
-        const ImVec2 rect = ImGui::GetIO().DisplaySize;
-        if (point.x < 0.0) {
-            const float overshootX = abs(point.x);
-            if (overshootX > CLAMP_MAX_OVERSHOOT) point.x += overshootX - CLAMP_MAX_OVERSHOOT;
-        } else if (point.x > rect.x) {
-            const float overshootX = point.x - rect.x;
-            if (overshootX > CLAMP_MAX_OVERSHOOT) point.x -= overshootX - CLAMP_MAX_OVERSHOOT;
-        }
-
-        if (point.y < 0.0) {
-            const float overshootY = abs(point.y);
-            if (overshootY > CLAMP_MAX_OVERSHOOT) point.y += overshootY - CLAMP_MAX_OVERSHOOT;
-        } else if (point.y > rect.y) {
-            const float overshootY = point.y - rect.y;
-            if (overshootY > CLAMP_MAX_OVERSHOOT) point.y -= overshootY - CLAMP_MAX_OVERSHOOT;
-        }
+void SubManager::FlushMove() {
+    if (const auto pending = std::exchange(pending_move_, std::nullopt)) {
+        SendEvent(pending->first, SkyPromptAPI::PromptEventType::kMove, pending->second);
     }
 }
 
 ImVec2 SubManager::GetAttachedObjectPos() const {
-    if (const auto ref = GetAttachedObject()) {
-        constexpr float padding = 10.f;
-        RE::NiPoint3 pos;
-        ImVec2 pos2d;
-
-        if (const auto temp_ref = RE::Inventory3DManager::GetSingleton()->tempRef;
-            temp_ref && ref->GetFormID() == temp_ref->GetFormID()) {
-            if (const auto inv3dmngr = RE::Inventory3DManager::GetSingleton(); !inv3dmngr->GetRuntimeData().loadedModels
-                .empty()) {
-                if (const auto& model = inv3dmngr->GetRuntimeData().loadedModels.back().spModel) {
-                    OffsetRight(model->world.translate, RE::UI3DSceneManager::GetSingleton()->cachedCameraPos, pos,
-                                model->worldBound.radius);
-                    pos2d = WorldToScreenLoc(pos, RE::UI3DSceneManager::GetSingleton()->camera) + ImVec2{
-                                (Theme::last_theme->prompt_size + padding) * DisplayTweaks::resolutionScale, 0};
-                }
-            }
-        } else if (const auto a_head = [&]() -> RE::NiAVObject* {
-            if (const auto actor = ref->As<RE::Actor>()) {
-                if (const auto middle = actor->GetMiddleHighProcess()) {
-                    return middle->headNode;
-                }
-            }
-            return nullptr;
-        }()) {
-            constexpr float npc_head_size = 15.f;
-            const float objectScale = ref->GetScale();
-            const auto cameraPos = RE::PlayerCamera::GetSingleton()->GetRuntimeData2().pos;
-            const auto npc_head_pos = a_head->world.translate;
-            const auto diff = npc_head_pos - cameraPos;
-            constexpr RE::NiPoint3 z_vec(0.f, 0.f, 1.f);
-            const auto right_vec = diff.UnitCross(z_vec);
-            pos = npc_head_pos + right_vec * (npc_head_size * objectScale);
-            pos2d = WorldToScreenLoc(pos) + ImVec2{
-                        (Theme::last_theme->prompt_size + padding) * DisplayTweaks::resolutionScale, 0};
-        } else {
-            DirectX::BoundingOrientedBox bounding_box;
-            BoundingBox::GetOBB(ref, bounding_box, true);
-
-            const auto center = bounding_box.Center;
-
-            pos = RE::NiPoint3{center.x, center.y, center.z + bounding_box.Extents.z + 10.f};
-            pos2d = WorldToScreenLoc(pos);
-
-            pos2d += ImVec2{0.f, -(Theme::last_theme->prompt_size + padding) * DisplayTweaks::resolutionScale};
-        }
-
-        FastClampToScreen(pos2d);
-
-        return pos2d;
-    }
-    return {};
+    return Platform::GetAttachedObjectPos(GetAttachedObject());
 }
 
 RE::TESObjectREFR* SubManager::GetAttachedObject() const {
-    std::shared_lock lock(q_mutex_);
-    if (const auto curr_button = interactQueue.current_button) {
+    if (const auto curr_button = interactQueue.GetCurrent()) {
         return curr_button->attached_object.get().get();
     }
     return nullptr;
 }
 
-void SubManager::Update(const SkyPromptAPI::ClientID a_client_id, const SkyPromptAPI::PromptSink* a_prompt_sink) const {
-    using Update = ButtonMutables;
-    std::map<Interaction, Update> updates;
-    for (const auto prompts = a_prompt_sink->GetPrompts(); const auto& prompt : prompts) {
-        auto a_text = std::string(prompt.text);
-        if (a_text.empty()) {
-            logger::warn("Empty prompt text for interaction {}", prompt.eventID);
-            continue;
-        }
-        TranslateEmbedded(a_text);
-        const auto a_interaction = Manager::MakeInteraction(a_client_id, prompt.eventID, prompt.actionID);
-        updates[a_interaction] = Update(a_text, prompt.text_color, prompt.progress);
-    }
-    if (updates.empty()) {
+void SubManager::Update(const SkyPromptAPI::ClientID a_client_id, const SkyPromptAPI::PromptSink* a_prompt_sink) {
+    const auto& submitted = Manager::GetSingleton()->GetSubmitted(a_prompt_sink);
+    if (!submitted) {
         return;
     }
-    std::unique_lock lock(q_mutex_);
-    for (const auto& a_button : interactQueue.buttons) {
-        if (updates.contains(a_button.interaction)) {
-            a_button.mutables = updates.at(a_button.interaction);
+    const std::span<const SkyPromptAPI::Prompt> prompts = submitted->prompts;
+    for (size_t i = 0; i < prompts.size(); ++i) {
+        const auto& prompt = prompts[i];
+        const auto a_interaction = Manager::MakeInteraction(a_client_id, prompt.eventID, prompt.actionID);
+        // only prompts this queue holds; the sink's others live in other SubManagers
+        const auto index = interactQueue.Find(a_interaction);
+        if (index == ButtonQueue::npos) {
+            continue;
+        }
+        // mods that resend every frame usually only move the progress; look up only text that changed
+        auto& a_mutables = interactQueue.buttons[index].mutables;
+        if (a_mutables.text.Source() != prompt.text) {
+            if (prompt.text.empty()) {
+                logger::warn("Empty prompt text for interaction {}", prompt.eventID);
+                continue;
+            }
+            a_mutables.text = PromptText::Ref(prompt.text);
+        }
+        a_mutables.text_color = prompt.text_color;
+        a_mutables.progress = prompt.progress;
+        if (prompt.progress != 0.f) {
+            progress_hint_ = true;
+        }
+        if (const auto it = sinks.find(a_interaction); it != sinks.end()) {
+            for (auto& a_entry : it->second) {
+                if (a_entry.sink == a_prompt_sink) {
+                    std::tie(a_entry.first, a_entry.last) = SameAction(prompts, i);
+                }
+            }
         }
     }
 }
 
-void SubManager::Show(const InteractionButton* button2show) {
-    interactQueue.Show(progress_circle, button2show, buttonState);
+void SubManager::Show(const size_t index2show) {
+    interactQueue.Show(progress_circle, index2show, buttonState);
 }
 
 void SubManager::ButtonStateActions() {
-    buttonState.pressCount = std::min(6, buttonState.pressCount);
-
     SkyPromptAPI::PromptType a_type;
     float progress_override;
     Interaction a_interaction;
 
-    {
-        std::shared_lock lock(q_mutex_);
-        if (const auto button = interactQueue.current_button) {
-            a_type = button->type;
-            progress_override = button->GetProgressOverride(false);
-            a_interaction = button->interaction;
-        } else {
-            return;
-        }
+    if (const auto button = interactQueue.GetCurrent()) {
+        a_type = button->type;
+        progress_override = button->GetProgressOverride(false);
+        a_interaction = button->interaction;
+    } else {
+        return;
     }
 
     if (PromptTypeFlags::GetHasProgress(a_type)) {
-        if (const auto now = std::chrono::steady_clock::now(); !buttonState.isPressing) {
-            if (now - buttonState.lastPressTime > maxIntervalBetweenPresses) {
-                if (buttonState.pressCount == 2) {
-                    RemoveCurrentPrompt();
-                    SendEvent(a_interaction, SkyPromptAPI::PromptEventType::kDeclined);
-                } else if (buttonState.pressCount == 3) {
-                    NextPrompt();
-                }
-                buttonState.pressCount = 0;
-            } else if (buttonState.pressCount == 4 || buttonState.pressCount >= 6) {
+        switch (buttonState.Tick(PressGesture::Clock::now(), maxIntervalBetweenPresses, true)) {
+            case PressGesture::Action::kDecline:
+                RemoveCurrentPrompt();
+                SendEvent(a_interaction, SkyPromptAPI::PromptEventType::kDeclined);
+                break;
+            case PressGesture::Action::kSkip:
                 NextPrompt();
-                buttonState.pressCount = 5;
-            }
+                break;
+            default:
+                break;
         }
     } else {
+        (void)buttonState.Tick(PressGesture::Clock::now(), maxIntervalBetweenPresses, false);
+        if (std::abs(progress_override) < EPSILON) {
+            progress_hint_ = false;
+        }
         const auto [mult, frac] = splitFloat(progress_override);
         if (mult > 0.f && std::abs(frac) < EPSILON) {
             SendEvent(a_interaction, SkyPromptAPI::PromptEventType::kDeclined, {0.f, 0.f}, progress_override);
@@ -555,30 +456,40 @@ void SubManager::ButtonStateActions() {
     }
 }
 
-SubManager::~SubManager() {
-    ClearQueue();
-}
-
-void SubManager::Add2Q(const InteractionButton& iButton, const bool show) {
-    std::unique_lock lock(q_mutex_);
-    if (const auto button = interactQueue.AddButton(iButton); button && show) {
-        std::shared_lock lock2(progress_mutex_);
+void SubManager::Add2Q(InteractionButton&& iButton, const bool show) {
+    if (iButton.mutables.progress != 0.f) {
+        progress_hint_ = true;
+    }
+    if (const auto index = interactQueue.AddButton(std::move(iButton)); index != ButtonQueue::npos && show) {
         if (!Manager::GetSingleton()->IsPaused() && progress_circle == 0.f) {
-            Show(button);
+            Show(index);
         }
     }
 }
 
+void SubManager::Press(const bool a_pressed, const bool a_down, const bool a_up,
+                       const PressGesture::Clock::time_point a_time) {
+    buttonState.Button(a_pressed, a_down, a_time, PromptTypeFlags::GetHasProgress(GetPromptType()));
+    if (a_down) {
+        SendEvent(GetCurrentInteraction(), SkyPromptAPI::PromptEventType::kDown);
+    } else if (a_up) {
+        SendEvent(GetCurrentInteraction(), SkyPromptAPI::PromptEventType::kUp);
+    }
+    if (buttonState.presses > 0 || !buttonState.pressing) {
+        UpdateProgressCircle(buttonState.pressing);
+    }
+}
+
 bool SubManager::RemoveFromQ(const Interaction& a_interaction) {
-    std::unique_lock lock(q_mutex_);
     return interactQueue.RemoveButton(a_interaction);
 }
 
 void SubManager::RemoveFromQ(const SkyPromptAPI::PromptSink* a_prompt_sink) {
-    std::unique_lock lock(sink_mutex_);
     for (auto it = sinks.begin(); it != sinks.end();) {
         auto a_interaction = it->first;
-        if (std::erase(it->second, a_prompt_sink)) {
+        if (std::erase_if(it->second, [a_prompt_sink](const SinkEntry& a_entry) {
+            return a_entry.sink == a_prompt_sink;
+        })) {
             RemoveFromQ(a_interaction);
         }
 
@@ -591,62 +502,44 @@ void SubManager::RemoveFromQ(const SkyPromptAPI::PromptSink* a_prompt_sink) {
 }
 
 void SubManager::RemoveCurrentPrompt() {
-    if (std::shared_lock lock(q_mutex_); interactQueue.current_button) {
-        lock.unlock();
-        {
-            std::unique_lock lock2(q_mutex_);
-            interactQueue.Reset();
-            const auto* next_button = interactQueue.size() > 1 ? interactQueue.Next() : nullptr;
-            interactQueue.RemoveButton(interactQueue.current_button->interaction);
-            interactQueue.current_button = next_button;
-        }
-        {
-            std::unique_lock lock2(progress_mutex_);
-            progress_circle = 0.0f;
-        }
+    if (interactQueue.RemoveCurrent()) {
+        progress_circle = 0.0f;
     }
 }
 
 void SubManager::ResetQueue() {
-    {
-        std::unique_lock lock(q_mutex_);
-        interactQueue.Reset();
-    }
-    {
-        std::unique_lock lock(progress_mutex_);
-        progress_circle = 0.0f;
-        buttonState.Reset();
-    }
+    interactQueue.Reset();
+    progress_circle = 0.0f;
+    buttonState.Reset();
 }
 
 void SubManager::ShowQueue() {
-    if (std::shared_lock lock(q_mutex_); !interactQueue.IsEmpty()) {
-        const auto curr_ = interactQueue.current_button;
+    if (!interactQueue.IsEmpty()) {
+        const auto curr_ = interactQueue.GetCurrent();
         if (!curr_ || interactQueue.IsHidden()) {
-            {
-                std::unique_lock lock2(progress_mutex_);
-                progress_circle = 0.0f;
-            }
+            progress_circle = 0.0f;
         }
         if (interactQueue.expired()) {
+            // once per button per fade-out, not once per frame of it
             for (auto& button : interactQueue.buttons) {
-                SendEvent(button.interaction, SkyPromptAPI::PromptEventType::kTimingOut);
+                if (!std::exchange(button.timing_out_sent, true)) {
+                    SendEvent(button.interaction, SkyPromptAPI::PromptEventType::kTimingOut);
+                }
             }
         }
-        Show(nullptr);
+        Show(ButtonQueue::npos);
     }
 }
 
 void SubManager::WakeUpQueue() {
-    std::unique_lock lock(q_mutex_);
     interactQueue.WakeUp();
-    wakeup_queued_.store(false);
+    wakeup_queued_ = false;
 }
 
 SubManager* Manager::Add2Q(
     const SkyPromptAPI::ClientID a_clientID, const Interaction& a_interaction, const ButtonMutables& a_mutables,
-    const SkyPromptAPI::PromptType a_type, const RefID a_refid, const std::map<Input::DEVICE, uint32_t>& a_bttn_map,
-    const bool show) {
+    const SkyPromptAPI::PromptType a_type, const RefID a_refid, const InteractionButton::Keys& a_keys,
+    const double a_priority, const bool show) {
     const auto manager_list = GetManagerList(a_clientID);
     if (!manager_list) {
         return nullptr;
@@ -654,38 +547,217 @@ SubManager* Manager::Add2Q(
 
     std::unique_lock lock(mutex_);
 
-    for (const auto& a_manager : *manager_list) {
-        if (std::ranges::any_of(a_manager->GetInteractions(),
-                                [&](const auto& i) { return i == a_interaction; })) {
-            return a_manager.get();
+    const auto slot_of = [manager_list](const SubManager* a_manager) -> int {
+        for (int i = 0; i < static_cast<int>(manager_list->size()); ++i) {
+            if ((*manager_list)[i].get() == a_manager) {
+                return i;
+            }
+        }
+        return -1;
+    };
+
+    if (const auto it = interaction_index_.find(a_interaction.Key()); it != interaction_index_.end()) {
+        if (slot_of(it->second) >= 0 && it->second->IsInQueue(a_interaction)) {
+            return it->second;
         }
+        interaction_index_.erase(it);
     }
 
-    int index = 0;
-    for (const auto& a_manager : *manager_list) {
-        if (const auto& interactions = a_manager->GetInteractions(); interactions.empty()) {
-            const auto iButton = InteractionButton(a_interaction, a_mutables, a_type, a_refid, a_bttn_map, index);
-            a_manager->Add2Q(iButton, show);
-            return a_manager.get();
-        } else if (interactions.front().event == a_interaction.event) {
+    SubManager* a_manager = nullptr;
+    int index = -1;
+    if (const auto it = event_index_.find(a_interaction.event); it != event_index_.end()) {
+        if (index = slot_of(it->second); index >= 0 && it->second->HasEvent(a_interaction.event)) {
+            a_manager = it->second;
             a_manager->WakeUpQueue();
-            const auto iButton = InteractionButton(a_interaction, a_mutables, a_type, a_refid, a_bttn_map, index);
-            a_manager->Add2Q(iButton, show);
-            return a_manager.get();
+        } else {
+            event_index_.erase(it);
         }
-        ++index;
     }
 
-    if (manager_list->size() < Theme::last_theme->n_max_buttons) {
-        // if no manager has the event, make a new manager
-        manager_list->emplace_back(std::make_unique<SubManager>());
-    } else {
+    if (!a_manager) {
+        // take the first free slot, or open a new one
+        for (index = 0; index < static_cast<int>(manager_list->size()); ++index) {
+            if (!(*manager_list)[index]->HasQueue()) {
+                a_manager = (*manager_list)[index].get();
+                break;
+            }
+        }
+    }
+
+    if (!a_manager && manager_list->size() >= static_cast<size_t>(Theme::last_theme->n_max_buttons)) {
+        // the sink-level Add2Q made room before adding anything, so only a theme change gets here
         return nullptr;
     }
 
-    const auto iButton = InteractionButton(a_interaction, a_mutables, a_type, a_refid, a_bttn_map, index);
-    manager_list->back()->Add2Q(iButton, show);
-    return manager_list->back().get();
+    if (!a_manager) {
+        // if no manager has the event, make a new manager
+        index = static_cast<int>(manager_list->size());
+        a_manager = manager_list->emplace_back(std::make_unique<SubManager>(clock_)).get();
+    }
+
+    if (auto& slot_priority = slot_priorities_[a_manager]; !a_manager->HasQueue() || slot_priority < a_priority) {
+        slot_priority = a_priority;
+    }
+    a_manager->Add2Q(InteractionButton(a_interaction, a_mutables, a_type, a_refid, a_keys, index), show);
+    if (manager_list == &managers && !armed_.contains(a_manager)) {
+        Arm(a_manager);
+    }
+    interaction_index_[a_interaction.Key()] = a_manager;
+    event_index_[a_interaction.event] = a_manager;
+    pending_clients_.Set(a_clientID, true);
+    return a_manager;
+}
+
+double Manager::Now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double Manager::PriorityOf(const SkyPromptAPI::ClientID a_clientID, const SkyPromptAPI::PromptSink* a_sink) const {
+    const auto it = priorities_.find({a_clientID, a_sink});
+    return it != priorities_.end() ? it->second : 0;
+}
+
+void Manager::Park(const SkyPromptAPI::ClientID a_clientID, const SkyPromptAPI::PromptSink* a_sink) {
+    // a sink that is already waiting keeps its place, and with it the time it has waited
+    waiting_[a_clientID].Push(a_sink, PriorityOf(a_clientID, a_sink) - aging_per_second * Now());
+}
+
+size_t Manager::FreeSlots(const std::vector<std::unique_ptr<SubManager>>& a_list) const {
+    const auto n_max = static_cast<size_t>(std::max(Theme::last_theme->n_max_buttons, 0));
+    return n_max - std::min(n_max, a_list.size()) +
+           static_cast<size_t>(std::ranges::count_if(a_list, [](const auto& a_manager) {
+               return !a_manager->HasQueue();
+           }));
+}
+
+size_t Manager::SlotsNeeded(const std::vector<std::unique_ptr<SubManager>>& a_list,
+                            const SkyPromptAPI::ClientID a_clientID, const SkyPromptAPI::PromptSink* a_sink) const {
+    const auto& submitted = GetSubmitted(a_sink);
+    if (!submitted) {
+        return 0;
+    }
+    const auto& prompts = submitted->prompts;
+    size_t needed = 0;
+    for (size_t i = 0; i < prompts.size(); ++i) {
+        const auto event_id = prompts[i].eventID;
+        if (std::ranges::any_of(prompts.begin(), prompts.begin() + static_cast<std::ptrdiff_t>(i),
+                                [event_id](const SkyPromptAPI::Prompt& a_prompt) {
+                                    return a_prompt.eventID == event_id;
+                                })) {
+            continue;
+        }
+        const auto event = MakeInteraction(a_clientID, event_id, 0).event;
+        if (std::ranges::none_of(a_list, [event](const auto& a_manager) { return a_manager->HasEvent(event); })) {
+            ++needed;
+        }
+    }
+    return needed;
+}
+
+bool Manager::Preempt(const std::vector<std::unique_ptr<SubManager>>& a_list, const SkyPromptAPI::PromptSink* a_sink,
+                      const double a_priority, const size_t a_count,
+                      std::vector<const SkyPromptAPI::PromptSink*>& a_victims) {
+    // an empty slot has nothing to push out, and its priority is gone with DropFromIndex
+    std::vector<std::pair<double, SubManager*>> candidates;
+    for (const auto& a_manager : a_list) {
+        // never push out the sink's own prompts
+        if (!a_manager->HasQueue() || a_manager->IsInQueue(a_sink)) {
+            continue;
+        }
+        const auto it = slot_priorities_.find(a_manager.get());
+        if (const double priority = it != slot_priorities_.end() ? it->second : 0; priority < a_priority) {
+            candidates.emplace_back(priority, a_manager.get());
+        }
+    }
+    if (candidates.size() < a_count) {
+        return false;
+    }
+    std::ranges::partial_sort(candidates, candidates.begin() + static_cast<std::ptrdiff_t>(a_count), std::less{},
+                              &std::pair<double, SubManager*>::first);
+
+    // the prompts that were showing go back to waiting; their clients are not told, they just reappear later
+    for (size_t i = 0; i < a_count; ++i) {
+        const auto victim = candidates[i].second;
+        for (const auto a_victim_sink : victim->GetSinks()) {
+            if (std::ranges::find(a_victims, a_victim_sink) == a_victims.end()) {
+                a_victims.push_back(a_victim_sink);
+            }
+            // the rest of the victim goes with it, so it is never left half on screen
+            for (const auto& a_manager : a_list) {
+                if (a_manager.get() != victim) {
+                    a_manager->RemoveFromQ(a_victim_sink);
+                }
+            }
+        }
+        victim->ClearQueue();
+        victim->ClearSinks();
+        DropFromIndex(victim);
+    }
+    queues_dirty_ = true;
+    return true;
+}
+
+void Manager::AdmitWaiting() {
+    std::vector<const SkyPromptAPI::PromptSink*> admitted;
+    SkyPromptAPI::ClientID a_clientID;
+    {
+        std::unique_lock lock(mutex_);
+        a_clientID = last_clientID;
+        const auto it = waiting_.find(a_clientID);
+        if (it == waiting_.end() || it->second.Empty()) {
+            return;
+        }
+        auto& heap = it->second;
+
+        // slots promised to sinks admitted earlier in this pass are still empty until Add2Q fills them
+        size_t reserved = 0;
+        std::vector<const SkyPromptAPI::PromptSink*> victims;
+        while (!heap.Empty()) {
+            const auto a_sink = heap.Top();
+            const auto needed = SlotsNeeded(managers, a_clientID, a_sink);
+            const auto free_slots = FreeSlots(managers) - reserved;
+            if (needed > free_slots &&
+                !Preempt(managers, a_sink, PriorityOf(a_clientID, a_sink), needed - free_slots, victims)) {
+                break;
+            }
+            reserved += needed;
+            admitted.push_back(heap.Pop());
+        }
+        // parked only now, so a victim cannot win its slot straight back within the same pass
+        for (const auto a_victim : victims) {
+            Park(a_clientID, a_victim);
+        }
+    }
+
+    for (const auto a_sink : admitted) {
+        if (!Add2Q(a_sink, a_clientID)) {
+            Unregister(a_clientID, {a_sink});
+        }
+    }
+}
+
+void Manager::SetPriority(const SkyPromptAPI::PromptSink* a_prompt_sink, const SkyPromptAPI::ClientID a_clientID,
+                          const int a_priority) {
+    Push({.type = PromptCommand::Type::kSetPriority, .sink = a_prompt_sink, .clientID = a_clientID,
+          .priority = a_priority});
+}
+
+void Manager::Arm(SubManager* a_manager) {
+    const auto id = ++next_timer_id_;
+    armed_[a_manager] = id;
+    lifetimes_.Schedule({a_manager, id}, static_cast<uint64_t>(std::ceil(a_manager->GetDeadline() * ticks_per_second)));
+}
+
+void Manager::RefreshPending(const SkyPromptAPI::ClientID a_clientID) {
+    // called with mutex_ held, so no GetManagerList; and no operator[], which would add unknown clients
+    const std::vector<std::unique_ptr<SubManager>>* list = &managers;
+    if (a_clientID != last_clientID) {
+        const auto it = client_managers.find(a_clientID);
+        list = it != client_managers.end() ? &it->second : nullptr;
+    }
+    pending_clients_.Set(a_clientID, list && std::ranges::any_of(*list, [](const auto& a_manager) {
+        return a_manager && a_manager->HasQueue();
+    }));
 }
 
 bool Manager::SwitchToClientManager(const SkyPromptAPI::ClientID client_id) {
@@ -693,6 +765,8 @@ bool Manager::SwitchToClientManager(const SkyPromptAPI::ClientID client_id) {
         return false;
     }
 
+    ClearSnapshot();
+
     if (!MCP::Settings::cycle_controls.load()) {
         Clear(SkyPromptAPI::kRemovedByMod);
     } else {
@@ -709,6 +783,15 @@ bool Manager::SwitchToClientManager(const SkyPromptAPI::ClientID client_id) {
     managers = std::move(client_managers.at(client_id));
     last_clientID = client_id;
 
+    // lifetimes only run for the client on screen, so the incoming queues start theirs now
+    for (const auto& a_manager : managers) {
+        a_manager->ResetQueue();
+        if (a_manager->HasQueue()) {
+            Arm(a_manager.get());
+        }
+    }
+    queues_dirty_ = true;
+
     std::shared_lock theme_lock(Theme::m_theme_);
     const auto last_theme = Theme::last_theme;
     Theme::last_theme = Theme::themes.contains(last_clientID) ? Theme::themes.at(last_clientID) : &Theme::default_theme;
@@ -721,126 +804,454 @@ bool Manager::SwitchToClientManager(const SkyPromptAPI::ClientID client_id) {
 }
 
 bool Manager::CycleClient(const bool a_left) {
+    SkyPromptAPI::ClientID next;
+    {
+        std::shared_lock lock(mutex_);
+        const auto found = pending_clients_.Neighbour(last_clientID, a_left);
+        if (!found) {
+            return false;
+        }
+        next = *found;
+    }
+    return SwitchToClientManager(next);
+}
+
+bool Manager::CanCycle() const {
     std::shared_lock lock(mutex_);
-    if (client_managers.size() <= 1) {
+    return pending_clients_.Neighbour(last_clientID, false).has_value();
+}
+
+bool Manager::Add2Q(const SkyPromptAPI::PromptSink* a_prompt_sink, const SkyPromptAPI::ClientID a_clientID) {
+    const auto submitted = GetSubmitted(a_prompt_sink);
+    const auto manager_list = GetManagerList(a_clientID);
+    if (!submitted || !manager_list) {
         return false;
     }
-    const bool any_has_queue = std::ranges::any_of(client_managers | std::views::values,
-                                                   [](const auto& managers) {
-                                                       return !managers.empty() && std::ranges::any_of(
-                                                                  managers, [](const auto& m) {
-                                                                      return m && m->HasQueue();
-                                                                  });
-                                                   });
+    double priority;
+    {
+        std::unique_lock lock(mutex_);
+        priority = PriorityOf(a_clientID, a_prompt_sink);
+        // make room for the whole sink first, or wait with none of it on screen
+        const auto needed = SlotsNeeded(*manager_list, a_clientID, a_prompt_sink);
+        if (const auto free_slots = FreeSlots(*manager_list); needed > free_slots) {
+            std::vector<const SkyPromptAPI::PromptSink*> victims;
+            if (!Preempt(*manager_list, a_prompt_sink, priority, needed - free_slots, victims)) {
+                Park(a_clientID, a_prompt_sink);
+                return true;
+            }
+            for (const auto a_victim : victims) {
+                Park(a_clientID, a_victim);
+            }
+        }
+        if (const auto it = waiting_.find(a_clientID); it != waiting_.end()) {
+            it->second.Erase(a_prompt_sink);
+        }
+    }
+    for (size_t a_index = 0;
+         const auto& [text, a_event, a_action, a_type, a_refid, button_key, text_color, progress] : submitted->
+         prompts) {
+        if (text.empty()) {
+            logger::warn("Empty prompt text");
+            return false;
+        }
+
+        InteractionButton::Keys temp_button_keys{};
+        for (const auto& [a_device, key] : button_key) {
+            Input::DEVICE device = Input::from_RE_device(a_device);
+            if (device == Input::DEVICE::kUnknown) {
+                continue;
+            }
+            if (const auto a_new_key = MANAGER(Input)->Convert(key, a_device)) {
+                temp_button_keys[device] = a_new_key;
+            }
+        }
+        const auto interaction = MakeInteraction(a_clientID, a_event, a_action);
+        const ButtonMutables a_mutables{text_color, progress, PromptText::Ref(text)};
+        if (const auto submanager = Add2Q(a_clientID, interaction, a_mutables, a_type, a_refid,
+                                          temp_button_keys, priority, true)) {
+            if (!GetManagerList(a_clientID)) {
+                logger::error("Failed to get manager list");
+                return false;
+            }
+            submanager->AddSink(interaction, a_prompt_sink, submitted->prompts, a_index);
+        } else {
+            logger::warn("Failed to add interaction to the queue");
+            return false;
+        }
+        ++a_index;
+    }
+
+    SwitchToClientManager(a_clientID);
+
+    return true;
+}
+
+bool Manager::IsInQueue(const SkyPromptAPI::ClientID a_clientID, const SkyPromptAPI::PromptSink* a_prompt_sink,
+                        const bool wake_up) {
+    bool result = false;
+
+    const auto a_list = GetManagerList(a_clientID);
+
+    if (!a_list) {
+        return false;
+    }
+
+    std::shared_lock lock(mutex_);
+    for (const auto& a_manager : *a_list) {
+        if (a_manager->IsInQueue(a_prompt_sink)) {
+            result = true;
+            if (wake_up) {
+                a_manager->Update(a_clientID, a_prompt_sink);
+                a_manager->WakeUpQueue();
+            } else {
+                return result;
+            }
+        }
+    }
+    return result;
+}
+
+void Manager::RemoveFromQ(const SkyPromptAPI::ClientID a_clientID, const SkyPromptAPI::PromptSink* a_prompt_sink) {
+    const auto manager_list = GetManagerList(a_clientID);
+
+    if (!manager_list) {
+        return;
+    }
+
+    {
+        std::unique_lock lock(mutex_);
+        for (const auto& a_manager : *manager_list) {
+            a_manager->RemoveFromQ(a_prompt_sink);
+        }
+        if (const auto it = waiting_.find(a_clientID); it != waiting_.end()) {
+            it->second.Erase(a_prompt_sink);
+        }
+        priorities_.erase({a_clientID, a_prompt_sink});
+        RefreshPending(a_clientID);
+        queues_dirty_ = true;
+    }
+    {
+        // the caller may free the sink as soon as this returns
+        std::lock_guard lock(events_mutex_);
+        std::erase_if(events_back_, [a_prompt_sink](const PendingEvent& a_event) {
+            return a_event.sink == a_prompt_sink;
+        });
+        dropped_sinks_.push_back(a_prompt_sink);
+        batch_callbacks_.erase(a_prompt_sink);
+        drop_generation_.fetch_add(1, std::memory_order_release);
+    }
+
+    CleanUpQueue();
+}
+
+SubmittedPrompts::SubmittedPrompts(const std::span<const SkyPromptAPI::Prompt> a_prompts)
+    : prompts(a_prompts.begin(), a_prompts.end()) {
+    for (const auto& a_prompt : a_prompts) {
+        texts_.append(a_prompt.text);
+        keys_.insert(keys_.end(), a_prompt.button_key.begin(), a_prompt.button_key.end());
+    }
+    // only point into the buffers once they are done growing
+    size_t text_pos = 0;
+    size_t key_pos = 0;
+    for (auto& a_prompt : prompts) {
+        a_prompt.text = std::string_view(texts_).substr(text_pos, a_prompt.text.size());
+        a_prompt.button_key = std::span(keys_).subspan(key_pos, a_prompt.button_key.size());
+        text_pos += a_prompt.text.size();
+        key_pos += a_prompt.button_key.size();
+    }
+}
+
+bool Manager::Submit(const SkyPromptAPI::PromptSink* a_prompt_sink, const SkyPromptAPI::ClientID a_clientID) {
+    bool is_new;
+    {
+        std::lock_guard lock(registry_mutex_);
+        is_new = registered_sinks_.emplace(a_clientID, a_prompt_sink).second;
+    }
+
+    auto prompts = std::make_shared<const SubmittedPrompts>(a_prompt_sink->GetPrompts());
+    MANAGER(Trace)->Send(a_prompt_sink, a_clientID, prompts->prompts);
+    Push({.type = is_new ? PromptCommand::Type::kSend : PromptCommand::Type::kResend, .sink = a_prompt_sink,
+          .clientID = a_clientID, .prompts = std::move(prompts)});
+    return is_new;
+}
+
+void Manager::Withdraw(const SkyPromptAPI::PromptSink* a_prompt_sink, const SkyPromptAPI::ClientID a_clientID) {
+    {
+        std::lock_guard lock(registry_mutex_);
+        if (!registered_sinks_.erase({a_clientID, a_prompt_sink})) {
+            return;
+        }
+    }
+
+    {
+        // the caller may free the sink as soon as this returns; the queue lets go of it when the kRemove is applied
+        std::lock_guard lock(events_mutex_);
+        ++tombstones_[a_prompt_sink];
+        std::erase_if(events_back_, [a_prompt_sink](const PendingEvent& a_event) {
+            return a_event.sink == a_prompt_sink;
+        });
+        batch_callbacks_.erase(a_prompt_sink);
+        drop_generation_.fetch_add(1, std::memory_order_release);
+    }
+    if (delivery_thread_.load(std::memory_order_acquire) != std::this_thread::get_id()) {
+        while (delivering_.load(std::memory_order_acquire) == a_prompt_sink) {
+            std::this_thread::yield();
+        }
+    }
+
+    Push({.type = PromptCommand::Type::kRemove, .sink = a_prompt_sink, .clientID = a_clientID});
+}
+
+void Manager::Push(const PromptCommand& a_command) {
+    while (!submissions_.TryPush(a_command)) {
+        // the render thread is not ticking (e.g. loading screen); apply the backlog here unless a frame is under way,
+        // which drains the queue anyway
+        if (std::unique_lock lock(frame_mutex_, std::try_to_lock); lock.owns_lock()) {
+            ProcessSubmissions();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+size_t Manager::ProcessSubmissions() {
+    std::lock_guard lock(frame_mutex_);
+    PromptCommand command;
+    while (submissions_.TryPop(command)) {
+        switch (command.type) {
+            case PromptCommand::Type::kResend:
+                submitted_[command.sink] = command.prompts;
+                if (IsInQueue(command.clientID, command.sink, true)) {
+                    break;
+                }
+                // it left the queue before we got to it, add it again
+                [[fallthrough]];
+            case PromptCommand::Type::kSend:
+                submitted_[command.sink] = command.prompts;
+                if (!Add2Q(command.sink, command.clientID)) {
+                    // SendPrompt already returned, so this is the only way the sink hears about it
+                    for (const auto& a_prompt : command.prompts->prompts) {
+                        AddEventToSend(command.sink, a_prompt, SkyPromptAPI::kRemovedByMod, {}, command.prompts);
+                    }
+                    Unregister(command.clientID, {command.sink});
+                }
+                break;
+            case PromptCommand::Type::kRemove:
+                RemoveFromQ(command.clientID, command.sink);
+                submitted_.erase(command.sink);
+                {
+                    std::lock_guard events_lock(events_mutex_);
+                    if (const auto it = tombstones_.find(command.sink); it != tombstones_.end() && --it->second == 0) {
+                        tombstones_.erase(it);
+                    }
+                }
+                break;
+            case PromptCommand::Type::kSetPriority: {
+                // a sink already waiting keeps its place in line until it is parked again
+                std::unique_lock lock(mutex_);
+                if (command.priority == 0) {
+                    priorities_.erase({command.clientID, command.sink});
+                } else {
+                    priorities_[{command.clientID, command.sink}] = command.priority;
+                }
+                break;
+            }
+        }
+        command = {};
+    }
+    return submissions_.Consumed();
+}
+
+void Manager::PushInput(const InputCommand& a_command) {
+    using Type = InputCommand::Type;
+    if (!overflowing_.load() && inputs_.TryPush(a_command)) {
+        return;
+    }
+    // the render thread is not ticking; apply the backlog here unless a frame is under way. Not while this thread
+    // pins a snapshot: applying input can publish twice and would have to wait for that pin.
+    if (snapshot_pins == 0) {
+        if (std::unique_lock lock(frame_mutex_, std::try_to_lock); lock.owns_lock()) {
+            ProcessInputs();
+            if (inputs_.TryPush(a_command)) {
+                return;
+            }
+        }
+    }
 
-    if (!any_has_queue) {
-        return false;
+    std::lock_guard lock(overflow_mutex_);
+    overflowing_.store(true);
+    if (!overflow_.empty()) {
+        auto& last = overflow_.back();
+        const bool same = last.type == a_command.type && last.manager == a_command.manager &&
+                          last.managerID == a_command.managerID;
+        if (same && a_command.type == Type::kMove) {
+            last.delta.first += a_command.delta.first;
+            last.delta.second += a_command.delta.second;
+            last.moving = a_command.moving;
+            return;
+        }
+        // a key still held down: only the latest time counts
+        const auto repeat = [](const InputCommand& a_button) {
+            return a_button.pressed && !a_button.down && !a_button.up;
+        };
+        if (same && a_command.type == Type::kButton && repeat(last) && repeat(a_command)) {
+            last.time = a_command.time;
+            return;
+        }
     }
+    overflow_.push_back(a_command);
+}
 
-    auto it = client_managers.find(last_clientID);
-    while (it->first == last_clientID || it->second.empty()) {
-        if (a_left) {
-            if (it == client_managers.begin()) {
-                it = std::prev(client_managers.end());
-            } else {
-                --it;
-            }
+bool Manager::RouteInput(const PromptSnapshot& a_snapshot, const KeyInput& a_input) {
+    // the SubManagers belong to the render thread; everything but the blocking decision is handed over to it
+    using Type = InputCommand::Type;
+    bool block = false;
+    for (const auto& a_entry : a_snapshot.Find(a_input.key)) {
+        if (a_entry.blocks_input) {
+            block = true;
+        }
+        if (!a_entry.manager) {
+            continue;
+        }
+        if (a_input.type == KeyInput::Type::kButton) {
+            PushInput({.type = Type::kButton, .manager = a_entry.manager, .managerID = a_entry.managerID,
+                       .pressed = a_input.pressed, .down = a_input.down, .up = a_input.up, .time = a_input.time});
         } else {
-            ++it;
-            if (it == client_managers.end()) {
-                it = client_managers.begin();
-            }
+            PushInput({.type = Type::kMove, .manager = a_entry.manager, .managerID = a_entry.managerID,
+                       .delta = a_input.delta, .moving = a_input.delta.first != 0.f || a_input.delta.second != 0.f});
         }
     }
 
-    lock.unlock();
-    return SwitchToClientManager(it->first);
+    if (!block && a_input.type == KeyInput::Type::kButton && a_input.down) {
+        const auto device = MANAGER(Input)->GetInputDevice();
+        const bool is_L = a_input.key == MCP::Settings::cycle_L[device];
+        const bool is_R = a_input.key == MCP::Settings::cycle_R[device];
+        if ((is_L || is_R) && CanCycle()) {
+            PushInput({.type = Type::kCycle, .left = is_L});
+            block = true;
+        }
+    }
+    return block;
 }
 
-bool Manager::Add2Q(const SkyPromptAPI::PromptSink* a_prompt_sink, const SkyPromptAPI::ClientID a_clientID) {
-    for (const auto prompts = a_prompt_sink->GetPrompts();
-         const auto& [text, a_event, a_action, a_type, a_refid, button_key, text_color, progress] : prompts) {
-        auto a_txt = std::string(text);
-        if (a_txt.empty()) {
-            logger::warn("Empty prompt text");
-            return false;
+size_t Manager::ProcessInputs() {
+    std::lock_guard lock(frame_mutex_);
+    InputCommand command;
+    while (inputs_.TryPop(command)) {
+        ApplyInput(command);
+    }
+    if (overflowing_.load()) {
+        // everything in the ring is older, and nothing new goes there until the flag is down
+        std::vector<InputCommand> spilled;
+        {
+            std::lock_guard lock(overflow_mutex_);
+            spilled.swap(overflow_);
+            overflowing_.store(false);
+        }
+        for (const auto& a_command : spilled) {
+            ApplyInput(a_command);
         }
+    }
+    return inputs_.Consumed();
+}
 
-        TranslateEmbedded(a_txt);
+void Manager::ApplyInput(const InputCommand& a_command) {
+    using Type = InputCommand::Type;
+    switch (a_command.type) {
+        case Type::kCycle:
+            CycleClient(a_command.left);
+            return;
+        default:
+            break;
+    }
 
-        std::map<Input::DEVICE, uint32_t> temp_button_keys;
-        for (const auto& [a_device, key] : button_key) {
-            Input::DEVICE device = Input::from_RE_device(a_device);
-            if (device == Input::DEVICE::kUnknown) {
-                continue;
-            }
-            if (const auto a_new_key = MANAGER(Input)->Convert(key, a_device)) {
-                temp_button_keys[device] = a_new_key;
+    SubManager* a_manager = nullptr;
+    {
+        // the prompt may have been withdrawn since the hook saw it
+        std::shared_lock lock(mutex_);
+        for (const auto& m : managers) {
+            if (m.get() == a_command.manager && m->GetId() == a_command.managerID) {
+                a_manager = m.get();
+                break;
             }
         }
-        const auto interaction = MakeInteraction(a_clientID, a_event, a_action);
-        if (const auto submanager = Add2Q(a_clientID, interaction, {a_txt, text_color, progress}, a_type, a_refid,
-                                          temp_button_keys, true)) {
-            if (!GetManagerList(a_clientID)) {
-                logger::error("Failed to get manager list");
-                return false;
-            }
-            submanager->AddSink(interaction, a_prompt_sink);
+    }
+    if (!a_manager) {
+        return;
+    }
+
+    if (a_command.type == Type::kButton) {
+        a_manager->Press(a_command.pressed, a_command.down, a_command.up, a_command.time);
+    } else {
+        if (Theme::last_theme->coalesce_move) {
+            a_manager->AccumulateMove(a_command.delta);
         } else {
-            logger::warn("Failed to add interaction to the queue");
-            return false;
+            a_manager->SendEvent(a_manager->GetCurrentInteraction(), SkyPromptAPI::PromptEventType::kMove,
+                                 a_command.delta);
         }
+        a_manager->UpdateProgressCircle(a_command.moving);
     }
-
-    SwitchToClientManager(a_clientID);
-
-    return true;
 }
 
-bool Manager::IsInQueue(const SkyPromptAPI::ClientID a_clientID, const SkyPromptAPI::PromptSink* a_prompt_sink,
-                        const bool wake_up) {
-    bool result = false;
-
-    const auto a_list = GetManagerList(a_clientID);
+void Manager::Defer(const std::chrono::milliseconds a_delay, std::function<void()> a_action) {
+    const auto frame = LockFrame();
+    Deferred entry{std::chrono::steady_clock::now() + a_delay, next_deferred_seq_++, std::move(a_action)};
+    if (running_deferred_) {
+        deferred_later_.push_back(std::move(entry));
+        return;
+    }
+    deferred_.push_back(std::move(entry));
+    std::ranges::push_heap(deferred_, std::less{});
+}
 
-    if (!a_list) {
-        return false;
+size_t Manager::RunDeferred() {
+    const auto frame = LockFrame();
+    const auto now = std::chrono::steady_clock::now();
+    size_t ran = 0;
+    running_deferred_ = true;
+    while (!deferred_.empty() && deferred_.front().deadline <= now) {
+        std::ranges::pop_heap(deferred_, std::less{});
+        const auto action = std::move(deferred_.back().action);
+        deferred_.pop_back();
+        action();
+        ++ran;
     }
+    running_deferred_ = false;
+    // actions deferred by the ones that ran go in now, so a zero delay waits for the next frame
+    for (auto& a_entry : deferred_later_) {
+        deferred_.push_back(std::move(a_entry));
+        std::ranges::push_heap(deferred_, std::less{});
+    }
+    deferred_later_.clear();
+    return ran;
+}
 
+void Manager::FlushMoves() const {
     std::shared_lock lock(mutex_);
-    for (const auto& a_manager : *a_list) {
-        if (a_manager->IsInQueue(a_prompt_sink)) {
-            result = true;
-            if (wake_up) {
-                a_manager->Update(a_clientID, a_prompt_sink);
-                a_manager->WakeUpQueue();
-            } else {
-                return result;
-            }
-        }
+    for (const auto& a_manager : managers) {
+        a_manager->FlushMove();
     }
-    return result;
 }
 
-void Manager::RemoveFromQ(const SkyPromptAPI::ClientID a_clientID, const SkyPromptAPI::PromptSink* a_prompt_sink) {
-    const auto manager_list = GetManagerList(a_clientID);
-
-    if (!manager_list) {
+void Manager::Unregister(const SkyPromptAPI::ClientID a_clientID,
+                         const std::vector<const SkyPromptAPI::PromptSink*>& a_sinks) {
+    if (a_sinks.empty()) {
         return;
     }
-
+    for (const auto a_sink : a_sinks) {
+        submitted_.erase(a_sink);
+    }
     {
+        // a sink that timed out never went through RemoveFromQ
         std::unique_lock lock(mutex_);
-        for (const auto& a_manager : *manager_list) {
-            a_manager->RemoveFromQ(a_prompt_sink);
+        for (const auto a_sink : a_sinks) {
+            priorities_.erase({a_clientID, a_sink});
         }
     }
-    {
-        std::unique_lock lock(events_to_send_mutex);
-        events_to_send_.erase(a_prompt_sink);
+    std::lock_guard lock(registry_mutex_);
+    for (const auto a_sink : a_sinks) {
+        registered_sinks_.erase({a_clientID, a_sink});
     }
-
-    CleanUpQueue();
 }
 
 bool Manager::HasTask() const {
@@ -852,116 +1263,118 @@ bool Manager::HasTask() const {
     return false;
 }
 
+FrameDemand Manager::GetFrameDemand() {
+    const auto frame = LockFrame();
+    FrameDemand demand;
+    // a queue that is fading out still has its buttons, so has_prompts covers it
+    demand.has_prompts = HasTask();
+    demand.pending_submissions = !submissions_.Empty();
+    demand.pending_inputs = !inputs_.Empty() || overflowing_.load();
+    demand.deferred_due = !deferred_.empty() && deferred_.front().deadline <= std::chrono::steady_clock::now();
+    {
+        std::lock_guard lock(events_mutex_);
+        demand.pending_events = !events_back_.empty();
+    }
+    demand.reload_lifetime = MCP::Settings::shouldReloadLifetime.load();
+    demand.reload_prompt_size = MCP::Settings::shouldReloadPromptSize.load();
+    return demand;
+}
+
 void SubManager::CleanUpQueue() {
     // if everything has expired AND has alpha=0, clear the queue
-    if (std::unique_lock lock(q_mutex_);
-        interactQueue.expired() && interactQueue.alpha <= 0.f
-    ) {
-        lock.unlock();
+    if (interactQueue.expired() && interactQueue.alpha <= 0.f) {
         ClearQueue(SkyPromptAPI::kTimeout);
     }
-    ButtonStateActions();
 }
 
-void SubManager::ClearQueue() {
-    {
-        std::unique_lock lock(q_mutex_);
-        interactQueue.Clear();
-    }
-    {
-        std::unique_lock lock(progress_mutex_);
-        progress_circle = 0.0f;
-    }
+bool SubManager::HasPendingActions() const {
+    return buttonState.presses > 0 || buttonState.pressing || progress_hint_;
+}
+
+bool SubManager::IsExpired() const {
+    return interactQueue.expired();
+}
 
-    blockProgress.store(false);
+double SubManager::GetDeadline() const {
+    return interactQueue.deadline();
+}
+
+void SubManager::ClearQueue() {
+    interactQueue.Clear();
+    progress_circle = 0.0f;
+    blockProgress = false;
 }
 
 void SubManager::ClearQueue(const SkyPromptAPI::PromptEventType a_event_type) {
-    {
-        std::shared_lock lock(q_mutex_);
-        for (const auto& a_button : interactQueue.buttons) {
-            SendEvent(a_button.interaction, a_event_type);
-        }
+    for (const auto& a_button : interactQueue.buttons) {
+        SendEvent(a_button.interaction, a_event_type);
     }
     ClearQueue();
 }
 
 bool SubManager::HasQueue() const {
-    std::shared_lock lock(q_mutex_);
     return !interactQueue.IsEmpty();
 }
 
 void SubManager::Start() {
-    blockProgress.store(false);
+    blockProgress = false;
 }
 
 void SubManager::Stop() {
     ResetQueue();
-    blockProgress.store(false);
+    blockProgress = false;
 }
 
 bool SubManager::UpdateProgressCircle(const bool isPressing) {
-    if (!wakeup_queued_.load()) {
-        wakeup_queued_.store(true);
-        clib_utilsQTR::Tasker::GetSingleton()->PushTask([] {
-                                                            Manager::GetSingleton()->WakeUpQueue();
-                                                        },
-                                                        100
-            );
+    if (!wakeup_queued_) {
+        wakeup_queued_ = true;
+        Manager::GetSingleton()->Defer(std::chrono::milliseconds(100), [] {
+            Manager::GetSingleton()->WakeUpQueue();
+        });
+    }
+
+    SkyPromptAPI::PromptType a_type = SkyPromptAPI::kSinglePress;
+    Interaction interaction;
+    if (const auto interaction_button = interactQueue.GetCurrent()) {
+        a_type = interaction_button->type;
+        interaction = interaction_button->interaction;
     }
 
+    const bool has_progress = PromptTypeFlags::GetHasProgress(a_type);
+    const bool is_holdandkeeptype = PromptTypeFlags::GetIsHoldAndKeepType(a_type);
+
     if (!isPressing) {
-        std::unique_lock lock(progress_mutex_);
         if (progress_circle > Theme::last_theme->progress_speed) {
-            buttonState.pressCount = 0;
+            buttonState.Feed(PressGesture::Event::kLongRelease, has_progress);
         }
         progress_circle = 0.0f;
-        blockProgress.store(false);
+        blockProgress = false;
         return false;
     }
-    if (blockProgress.load()) {
+    if (blockProgress) {
         return false;
     }
-    {
-        std::unique_lock lock(progress_mutex_);
-        progress_circle += GetSecondsSinceLastFrame() * Theme::last_theme->progress_speed * 4.f;
-    }
-
-    SkyPromptAPI::PromptType a_type = SkyPromptAPI::kSinglePress;
-    Interaction interaction;
-    {
-        std::shared_lock lock(q_mutex_);
-        if (interactQueue.current_button) {
-            const auto interaction_button = interactQueue.current_button;
-            a_type = interaction_button->type;
-            interaction = interaction_button->interaction;
-        }
-    }
-
-    const bool has_progress = PromptTypeFlags::GetHasProgress(a_type);
-    const bool is_holdandkeeptype = PromptTypeFlags::GetIsHoldAndKeepType(a_type);
+    progress_circle += Platform::GetSecondsSinceLastFrame() * Theme::last_theme->progress_speed * 4.f;
 
-    if (std::shared_lock lock(progress_mutex_); progress_circle > (has_progress ? progress_circle_max : 0.f)) {
+    if (progress_circle > (has_progress ? progress_circle_max : 0.f)) {
         progress_circle = is_holdandkeeptype ? progress_circle_max : 0.0f;
-        lock.unlock();
 
-        if (buttonState.pressCount == 3 && has_progress) {
-            buttonState.pressCount = 0;
+        if (buttonState.Feed(PressGesture::Event::kHoldComplete, has_progress) == PressGesture::Action::kDeleteAll) {
             ClearQueue(SkyPromptAPI::kDeclined);
         } else {
             if (a_type == SkyPromptAPI::kHold) {
                 Stop();
                 RemoveCurrentPrompt();
             }
-            const auto curr_button = GetCurrentButton();
             SendEvent(interaction, SkyPromptAPI::PromptEventType::kAccepted, {0.f, 0.f},
-                      curr_button ? curr_button->GetProgressOverride(false) : 0.f);
+                      GetCurrentProgressOverride());
             Start();
             if (!is_holdandkeeptype) {
-                blockProgress.store(true);
+                blockProgress = true;
             }
         }
 
+        Manager::GetSingleton()->MarkQueuesDirty();
         return true;
     }
 
@@ -969,25 +1382,22 @@ bool SubManager::UpdateProgressCircle(const bool isPressing) {
 }
 
 uint32_t SubManager::GetPromptKey() const {
-    if (std::shared_lock lock(q_mutex_); interactQueue.current_button) {
-        return interactQueue.current_button->GetKey();
+    if (const auto button = interactQueue.GetCurrent()) {
+        return button->GetKey();
     }
     return 0;
 }
 
 SkyPromptAPI::PromptType SubManager::GetPromptType() const {
-    if (std::shared_lock lock(q_mutex_); interactQueue.current_button) {
-        return interactQueue.current_button->type;
+    if (const auto button = interactQueue.GetCurrent()) {
+        return button->type;
     }
     return SkyPromptAPI::kSinglePress;
 }
 
 void SubManager::NextPrompt() {
-    {
-        std::unique_lock lock(q_mutex_);
-        if (const auto next = interactQueue.Next()) {
-            Show(next);
-        }
+    if (const auto next = interactQueue.Next(); next != ButtonQueue::npos) {
+        Show(next);
     }
     if (Tutorial::Tutorial2::showing_tutorial.load()) {
         const SCENES::Event a_id = Tutorial::client_id * std::numeric_limits<SkyPromptAPI::ClientID>::max();
@@ -995,84 +1405,76 @@ void SubManager::NextPrompt() {
             Tutorial::Tutorial2::to_be_deleted.erase(
                 static_cast<SkyPromptAPI::ActionID>(a_interaction.action - static_cast<ACTIONS::Action>(a_id)));
             if (Tutorial::Tutorial2::to_be_deleted.empty()) {
-                SKSE::GetTaskInterface()->AddTask([]() {
-                        SkyPromptAPI::RemovePrompt(Tutorial::Tutorial2::Sink::GetSingleton(), Tutorial::client_id);
-                        Tutorial::Tutorial2::showing_tutorial.store(false);
-                        if (!SkyPromptAPI::SendPrompt(Tutorial::Tutorial3::Sink::GetSingleton(), Tutorial::client_id)) {
-                            logger::error("Failed to Send Tutorial3 prompts.");
-                        }
+                // next frame, since removing the prompt may free this SubManager
+                Manager::GetSingleton()->Defer(std::chrono::milliseconds(0), [] {
+                    SkyPromptAPI::RemovePrompt(Tutorial::Tutorial2::Sink::GetSingleton(), Tutorial::client_id);
+                    Tutorial::Tutorial2::showing_tutorial.store(false);
+                    if (!SkyPromptAPI::SendPrompt(Tutorial::Tutorial3::Sink::GetSingleton(), Tutorial::client_id)) {
+                        logger::error("Failed to Send Tutorial3 prompts.");
                     }
-                    );
+                });
             }
         }
     }
 }
 
 bool SubManager::HasPrompt() const {
-    std::shared_lock lock(q_mutex_);
-    return interactQueue.current_button;
+    return interactQueue.GetCurrent();
 }
 
 bool SubManager::IsHidden() const {
     if (!HasPrompt()) {
         return true;
     }
-    std::shared_lock lock(q_mutex_);
     return interactQueue.IsHidden();
 }
 
-std::vector<Interaction> SubManager::GetInteractions() const {
-    std::shared_lock lock(q_mutex_);
-    std::vector<Interaction> interactions;
-    for (const auto& a_button : interactQueue.buttons) {
-        interactions.push_back(a_button.interaction);
-    }
-    return interactions;
-}
-
 Interaction SubManager::GetCurrentInteraction() const {
-    std::shared_lock lock(q_mutex_);
-    if (interactQueue.current_button) {
-        return interactQueue.current_button->interaction;
+    if (const auto button = interactQueue.GetCurrent()) {
+        return button->interaction;
     }
     return {};
 }
 
-std::vector<InteractionButton> SubManager::GetButtons() const {
-    std::shared_lock lock(q_mutex_);
-    std::vector<InteractionButton> buttons;
-    for (const auto& a_button : interactQueue.buttons) {
-        buttons.push_back(a_button);
+float SubManager::GetCurrentProgressOverride() const {
+    if (const auto button = interactQueue.GetCurrent()) {
+        return button->GetProgressOverride(false);
     }
-    return buttons;
+    return 0.f;
+}
+
+void SubManager::ClearSinks() {
+    sinks.clear();
 }
 
-const InteractionButton* SubManager::GetCurrentButton() const {
-    std::shared_lock lock(q_mutex_);
-    if (interactQueue.current_button) {
-        return interactQueue.current_button;
+void SubManager::AddSink(const Interaction& a_interaction, const SkyPromptAPI::PromptSink* a_sink,
+                         const std::span<const SkyPromptAPI::Prompt> a_prompts, const size_t a_index) {
+    const auto [first, last] = SameAction(a_prompts, a_index);
+    auto& a_sinks = sinks[a_interaction];
+    // if the sink is already in the queue, only its prompts may have moved
+    if (const auto it = std::ranges::find(a_sinks, a_sink, &SinkEntry::sink); it != a_sinks.end()) {
+        it->first = first;
+        it->last = last;
+        return;
     }
-    return nullptr;
+    a_sinks.push_back({a_sink, first, last});
 }
 
-void SubManager::AddSink(const Interaction& a_interaction, const SkyPromptAPI::PromptSink* a_sink) {
-    {
-        std::shared_lock lock(sink_mutex_);
-        // if the sink is already in the queue, return
-        if (const auto it = sinks.find(a_interaction); it != sinks.end()) {
-            if (std::ranges::find(it->second, a_sink) != it->second.end()) {
-                return;
+std::vector<const SkyPromptAPI::PromptSink*> SubManager::GetSinks() const {
+    std::vector<const SkyPromptAPI::PromptSink*> result;
+    for (const auto& a_sinks : sinks | std::views::values) {
+        for (const auto& a_entry : a_sinks) {
+            if (std::ranges::find(result, a_entry.sink) == result.end()) {
+                result.push_back(a_entry.sink);
             }
         }
     }
-    std::unique_lock lock(sink_mutex_);
-    sinks[a_interaction].push_back(a_sink);
+    return result;
 }
 
 bool SubManager::IsInQueue(const SkyPromptAPI::PromptSink* a_sink) const {
-    std::shared_lock lock(sink_mutex_);
     for (const auto& sinks_ : sinks | std::views::values) {
-        if (auto it = std::ranges::find(sinks_, a_sink); it != sinks_.end()) {
+        if (auto it = std::ranges::find(sinks_, a_sink, &SinkEntry::sink); it != sinks_.end()) {
             return true;
         }
     }
@@ -1080,40 +1482,47 @@ bool SubManager::IsInQueue(const SkyPromptAPI::PromptSink* a_sink) const {
 }
 
 bool SubManager::IsInQueue(const Interaction& a_interaction) const {
-    std::shared_lock lock(q_mutex_);
-    for (const auto& a_button : interactQueue.buttons) {
-        if (a_button.interaction == a_interaction) {
-            return true;
-        }
+    return interactQueue.Find(a_interaction) != ButtonQueue::npos;
+}
+
+void SubManager::SetSlot(const int a_slot) {
+    for (auto& a_button : interactQueue.buttons) {
+        a_button.default_key_index = a_slot;
+        a_button.resolved = {};
     }
-    return false;
 }
 
-uint32_t InteractionButton::GetKey() const {
-    const auto manager = MANAGER(Input)->GetSingleton();
-    const auto a_device = manager->GetInputDevice();
-    const auto it = keys.find(a_device);
-    return it != keys.end() ? it->second : MCP::Settings::prompt_keys.at(a_device).at(default_key_index);
+bool SubManager::HasEvent(const SCENES::Event a_event) const {
+    return !interactQueue.IsEmpty() && interactQueue.buttons.front().interaction.event == a_event;
+}
+
+const InteractionButton::Resolved& InteractionButton::Resolve() const {
+    const auto a_device = MANAGER(Input)->GetInputDevice();
+    auto& entry = resolved.at(a_device);
+    if (const auto version = MCP::Settings::bindings_version.load(std::memory_order_relaxed);
+        entry.version != version) {
+        const auto key = keys.at(a_device);
+        entry.key = key ? key : MCP::Settings::prompt_keys.at(a_device).at(default_key_index);
+        entry.icon = Platform::LookupIcon(entry.key);
+        entry.version = version;
+    }
+    return entry;
 }
 
 InteractionButton::InteractionButton(const Interaction& a_interaction, const Mutables& a_mutables,
                                      const SkyPromptAPI::PromptType a_type, const RefID a_refid,
-                                     std::map<Input::DEVICE, uint32_t> a_keys, const int a_default_key_index) {
+                                     const Keys& a_keys, const int a_default_key_index) {
     interaction = a_interaction;
     type = a_type;
     mutables = a_mutables;
-    if (const auto a_ref = RE::TESForm::LookupByID<RE::TESObjectREFR>(a_refid)) {
-        attached_object = a_ref->GetHandle();
-    } else if (const auto temp = RE::Inventory3DManager::GetSingleton()->tempRef) {
-        if (temp->GetFormID() == a_refid) {
-            attached_object = temp->GetHandle();
-        }
-    }
-    keys = std::move(a_keys);
+    attached_object = Platform::LookupRef(a_refid);
+    keys = a_keys;
     default_key_index = a_default_key_index;
 }
 
 void Manager::Start() {
+    // the SubManagers are the frame owner's; RenderPrompts calls this with the frame lock held
+    assert(frame_mutex_.HeldByCurrentThread());
     isPaused.store(false);
     std::unique_lock lock(mutex_);
     for (const auto& a_manager : managers) {
@@ -1123,6 +1532,8 @@ void Manager::Start() {
 
 void Manager::Stop() {
     isPaused.store(true);
+    const auto frame = LockFrame();
+    ClearSnapshot();
     std::unique_lock lock(mutex_);
     for (const auto& a_manager : managers) {
         a_manager->Stop();
@@ -1133,28 +1544,98 @@ void Manager::CleanUpQueue() {
     std::vector<size_t> to_remove;
 
     {
-        std::shared_lock lock(mutex_);
+        std::unique_lock lock(mutex_);
+        const auto is_active = [this](const SubManager* a_manager) {
+            return std::ranges::any_of(managers, [a_manager](const auto& m) { return m.get() == a_manager; });
+        };
+
+        // only queues whose lifetime ran out since last frame are looked at
+        lifetimes_.Advance(static_cast<uint64_t>(clock_ * ticks_per_second), [&](const auto& a_timer) {
+            const auto [a_manager, id] = a_timer;
+            const auto it = armed_.find(a_manager);
+            if (it == armed_.end() || it->second != id) {
+                return;
+            }
+            if (!is_active(a_manager)) {
+                // switched out; it is armed again when its client comes back
+                armed_.erase(it);
+            } else if (a_manager->IsExpired()) {
+                armed_.erase(it);
+                fading_.push_back(a_manager);
+            } else {
+                // the lifetime was restarted after the timer was set
+                Arm(a_manager);
+            }
+        });
+
+        std::erase_if(fading_, [&](SubManager* a_manager) {
+            if (!is_active(a_manager)) {
+                return true;
+            }
+            if (!a_manager->IsExpired()) {
+                Arm(a_manager);
+                return true;
+            }
+            a_manager->CleanUpQueue();
+            if (!a_manager->HasQueue()) {
+                queues_dirty_ = true;
+                return true;
+            }
+            return false;
+        });
+
+        for (const auto& a_manager : managers) {
+            if (a_manager->HasPendingActions()) {
+                a_manager->ButtonStateActions();
+                queues_dirty_ = true;
+            }
+        }
+
+        if (!queues_dirty_.exchange(false)) {
+            return;
+        }
         for (size_t i = 0; i < managers.size(); ++i) {
-            managers[i]->CleanUpQueue();
             if (!managers[i]->HasQueue()) {
                 to_remove.push_back(i);
             }
         }
     }
     if (!to_remove.empty()) {
+        std::vector<const SkyPromptAPI::PromptSink*> departed;
+        SkyPromptAPI::ClientID a_clientID;
+        ClearSnapshot();
         {
             std::unique_lock lock(mutex_);
+            a_clientID = last_clientID;
             std::sort(to_remove.rbegin(), to_remove.rend());
+            size_t first_removed = managers.size();
             for (const size_t idx : to_remove) {
-                managers.erase(managers.begin() + idx);
+                if (managers[idx]->HasQueue()) {
+                    continue; // refilled in the meantime
+                }
+                const auto a_sinks = managers[idx]->GetSinks();
+                departed.insert(departed.end(), a_sinks.begin(), a_sinks.end());
+                DropFromIndex(managers[idx].get());
+                managers.erase(managers.begin() + static_cast<std::ptrdiff_t>(idx));
+                first_removed = idx;
+            }
+            // slide the remaining managers into the freed slots; buttons stay where they are
+            for (size_t i = first_removed; i < managers.size(); ++i) {
+                managers[i]->SetSlot(static_cast<int>(i));
             }
+            RefreshPending(a_clientID);
+            const auto waiting = waiting_.find(a_clientID);
+            std::erase_if(departed, [this, &waiting](const SkyPromptAPI::PromptSink* a_sink) {
+                return std::ranges::any_of(managers, [a_sink](const auto& a_manager) {
+                    return a_manager->IsInQueue(a_sink);
+                }) || (waiting != waiting_.end() && waiting->second.Contains(a_sink));
+            });
         }
+        Unregister(a_clientID, departed);
         if (std::shared_lock lock(mutex_); managers.empty()) {
             lock.unlock();
             CycleClient(false);
-            return;
         }
-        ReArrange();
     }
 }
 
@@ -1163,8 +1644,13 @@ void Manager::ShowQueue() {
         return;
     }
 
+    if (Tutorial::showing_tutorial.load() || !IsGameFrozen()) {
+        std::unique_lock lock(mutex_);
+        clock_ += Platform::GetSecondsSinceLastFrame();
+    }
+
     // Get the screen size
-    const auto [width, height] = RE::BSGraphics::Renderer::GetScreenSize();
+    const auto [width, height] = Platform::GetScreenSize();
 
     // Calculate position
     const auto resScale = GetResolutionScale();
@@ -1176,54 +1662,66 @@ void Manager::ShowQueue() {
     // Set the window position
     SetNextWindowPos(bottomRightPos, ImGuiCond_Always, ImVec2(1.0f, 1.0f)); // Pivot at the bottom-right
     BeginImGuiWindow("SkyPrompt");
-    std::map<RefID, std::vector<SubManager*>> object_managers;
     renderBatch.clear();
 
-    for (std::shared_lock lock(mutex_);
-         auto& a_manager : managers) {
-        if (const auto a_ref = a_manager->GetAttachedObject()) {
-            object_managers[a_ref->GetFormID()].push_back(a_manager.get());
-            continue;
+    // managers attached to an object, grouped by object and kept in slot order within a group
+    struct Attached {
+        RefID refid;
+        size_t slot;
+        SubManager* manager;
+    };
+    std::span<Attached> attached;
+
+    {
+        std::shared_lock lock(mutex_);
+        attached = frameArena.MakeArray<Attached>(managers.size());
+        size_t n_attached = 0;
+        for (size_t i = 0; i < managers.size(); ++i) {
+            if (const auto a_ref = managers[i]->GetAttachedObject()) {
+                attached[n_attached++] = {a_ref->GetFormID(), i, managers[i].get()};
+                continue;
+            }
+            managers[i]->ShowQueue();
         }
-        a_manager->ShowQueue();
+        attached = attached.first(n_attached);
     }
+    std::ranges::sort(attached, [](const Attached& a, const Attached& b) {
+        return std::tie(a.refid, a.slot) < std::tie(b.refid, b.slot);
+    });
 
     RenderSkyPrompt();
 
     if (MCP::Settings::cycle_controls.load()) {
-        SkyPromptAPI::ClientID n_has_prompts = 0;
-        SkyPromptAPI::ClientID index = 0;
-        for (std::shared_lock lock(mutex_);
-             const auto& [a_clientID,a_managers] : client_managers) {
-            for (auto& a_manager : a_managers) {
-                if (a_manager && a_manager->HasQueue()) {
-                    n_has_prompts++;
-                    break;
-                }
-            }
-            if (a_clientID == last_clientID) {
-                index = n_has_prompts;
-            }
+        std::shared_lock lock(mutex_);
+        if (cycle_indicator_.version != pending_clients_.Version() || cycle_indicator_.client != last_clientID) {
+            cycle_indicator_ = {
+                pending_clients_.Version(), last_clientID,
+                static_cast<SkyPromptAPI::ClientID>(pending_clients_.Rank(last_clientID)),
+                static_cast<SkyPromptAPI::ClientID>(pending_clients_.Count() - pending_clients_.Test(last_clientID))
+            };
         }
-
-        if (n_has_prompts > 0) {
-            DrawCycleIndicators(index + 1, n_has_prompts + 1);
+        if (const auto [version, client, index, others] = cycle_indicator_; others > 0) {
+            lock.unlock();
+            DrawCycleIndicators(index + 1, others + 1);
         }
     }
 
     EndImGuiWindow();
 
     int i = 0;
-    for (std::shared_lock lock(mutex_);
-         const auto& managers_ : object_managers | std::views::values) {
-        auto window_pos = managers_[0]->GetAttachedObjectPos();
+    std::shared_lock lock(mutex_);
+    for (auto it = attached.begin(); it != attached.end();) {
+        const auto group_end = std::find_if(it, attached.end(), [refid = it->refid](const Attached& a) {
+            return a.refid != refid;
+        });
+        auto window_pos = it->manager->GetAttachedObjectPos();
         window_pos.x -= Theme::last_theme->marginX * resScale;
         window_pos.y -= Theme::last_theme->marginY * resScale;
         renderBatch.clear();
         SetNextWindowPos(window_pos, ImGuiCond_Always, ImVec2(0.5f, 0.5f));
-        BeginImGuiWindow(std::format("SkyPromptHover{}", i++).c_str());
-        for (const auto a_manager : managers_) {
-            a_manager->ShowQueue();
+        BeginImGuiWindow(frameArena.Format("SkyPromptHover{}", i++));
+        for (; it != group_end; ++it) {
+            it->manager->ShowQueue();
         }
         RenderSkyPrompt();
         EndImGuiWindow();
@@ -1231,11 +1729,28 @@ void Manager::ShowQueue() {
 }
 
 void Manager::Clear(const SkyPromptAPI::PromptEventType a_event_type) {
-    std::unique_lock lock(mutex_);
-    for (const auto& a_manager : managers) {
-        a_manager->ClearQueue(a_event_type);
+    std::vector<const SkyPromptAPI::PromptSink*> departed;
+    SkyPromptAPI::ClientID a_clientID;
+    ClearSnapshot();
+    {
+        std::unique_lock lock(mutex_);
+        a_clientID = last_clientID;
+        for (const auto& a_manager : managers) {
+            a_manager->ClearQueue(a_event_type);
+            const auto a_sinks = a_manager->GetSinks();
+            departed.insert(departed.end(), a_sinks.begin(), a_sinks.end());
+            DropFromIndex(a_manager.get());
+        }
+        managers.clear();
+        if (const auto it = waiting_.find(a_clientID); it != waiting_.end()) {
+            for (const auto& a_node : it->second) {
+                departed.push_back(a_node.key);
+            }
+            it->second.Clear();
+        }
+        pending_clients_.Set(a_clientID, false);
     }
-    managers.clear();
+    Unregister(a_clientID, departed);
 }
 
 Interaction Manager::MakeInteraction(const SkyPromptAPI::ClientID a_clientID, const SkyPromptAPI::EventID a_event,
@@ -1247,10 +1762,15 @@ Interaction Manager::MakeInteraction(const SkyPromptAPI::ClientID a_clientID, co
     return interaction;
 }
 
-void Manager::ResetQueue() const {
+void Manager::ResetQueue() {
     std::unique_lock lock(mutex_);
+    // the lifetime setting may have shrunk, so the old timers can be too late
+    fading_.clear();
     for (auto& a_manager : managers) {
         a_manager->ResetQueue();
+        if (a_manager->HasQueue()) {
+            Arm(a_manager.get());
+        }
     }
 }
 
@@ -1261,99 +1781,192 @@ void Manager::WakeUpQueue() const {
     }
 }
 
-bool Manager::IsHidden() const {
-    std::shared_lock lock(mutex_);
-    for (const auto& a_manager : managers) {
-        if (!a_manager->IsHidden()) {
-            return false;
+void PromptSnapshot::Insert(const Entry& a_entry) {
+    const auto it = std::ranges::upper_bound(entries, a_entry.key, {}, &Entry::key);
+    entries.insert(it, a_entry);
+}
+
+void PromptSnapshot::BuildTable() {
+    size_t n_keys = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (i == 0 || entries[i].key != entries[i - 1].key) {
+            ++n_keys;
         }
     }
-    return true;
+    table.assign(n_keys ? std::bit_ceil(n_keys * 2) : 0, {});
+    const auto mask = table.size() - 1;
+    for (size_t i = 0; i < entries.size();) {
+        const auto key = entries[i].key;
+        size_t end = i;
+        while (end < entries.size() && entries[end].key == key) {
+            ++end;
+        }
+        auto b = Hash(key) & mask;
+        while (table[b].key != 0) {
+            b = (b + 1) & mask;
+        }
+        table[b] = {key, static_cast<uint32_t>(i), static_cast<uint32_t>(end - i)};
+        i = end;
+    }
 }
 
-SubManager* Manager::GetSubManagerByKey(const uint32_t a_prompt_key) const {
-    std::shared_lock lock(mutex_);
-    for (auto& a_manager : managers) {
-        if (const auto key = a_manager->GetPromptKey(); key == a_prompt_key) {
-            return a_manager.get();
+Manager::SnapshotRef::SnapshotRef(const PromptSnapshot* a_snapshot, std::atomic<uint32_t>* a_readers)
+    : snapshot_(a_snapshot), readers_(a_readers) {
+    ++snapshot_pins;
+}
+
+Manager::SnapshotRef::~SnapshotRef() {
+    readers_->fetch_sub(1, std::memory_order_release);
+    --snapshot_pins;
+}
+
+Manager::SnapshotRef Manager::GetSnapshot() {
+    for (;;) {
+        const auto snapshot = snapshot_.load(std::memory_order_seq_cst);
+        auto& readers = snapshot_readers_[snapshot == &snapshots_[0] ? 0 : 1];
+        readers.fetch_add(1, std::memory_order_seq_cst);
+        // still published after the pin, so a writer looking for readers of this buffer will see us
+        if (snapshot_.load(std::memory_order_seq_cst) == snapshot) {
+            return {snapshot, &readers};
         }
+        readers.fetch_sub(1, std::memory_order_release);
     }
-    return nullptr;
 }
 
-std::vector<uint32_t> Manager::GetPromptKeys() const {
-    std::vector<uint32_t> keys;
-    for (std::shared_lock lock(mutex_); const auto& a_manager : managers) {
-        if (a_manager->IsHidden()) {
-            continue;
-        }
-        if (const auto key = a_manager->GetPromptKey(); key != 0) {
-            keys.push_back(key);
-        }
+PromptSnapshot& Manager::BackSnapshot() {
+    const auto back_index = snapshot_.load(std::memory_order_relaxed) == &snapshots_[0] ? 1 : 0;
+    // a reader may still hold the buffer from before the last swap; reads are a single input event long
+    while (snapshot_readers_[back_index].load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
     }
-    return keys;
+    auto& back = snapshots_[back_index];
+    back.entries.clear();
+    back.hidden = true;
+    return back;
 }
 
-std::vector<std::pair<SkyPromptAPI::PromptType, uint32_t>> Manager::GetPromptButtons() const {
-    std::vector<std::pair<SkyPromptAPI::PromptType, uint32_t>> buttons;
+void Manager::PublishSnapshot() {
+    std::lock_guard snapshot_lock(snapshot_mutex_);
+    auto& back = BackSnapshot();
     for (std::shared_lock lock(mutex_); const auto& a_manager : managers) {
         if (a_manager->IsHidden()) {
             continue;
         }
+        back.hidden = false;
         if (const auto key = a_manager->GetPromptKey(); key != 0) {
-            auto type = a_manager->GetPromptType();
-            buttons.emplace_back(type, key);
+            const auto type = a_manager->GetPromptType();
+            back.Insert({key, type, PromptTypeFlags::GetBlocksInput(type), a_manager.get(), a_manager->GetId()});
         }
     }
-    return buttons;
+    // the same prompts as last frame: keep the published table
+    if (const auto front = snapshot_.load(std::memory_order_relaxed);
+        front->hidden == back.hidden && front->entries == back.entries) {
+        return;
+    }
+    back.BuildTable();
+    snapshot_.store(&back, std::memory_order_seq_cst);
 }
 
-void Manager::ForEachManager(const std::function<void(std::unique_ptr<SubManager>&)>& a_func) {
-    std::unique_lock lock(mutex_);
-    for (auto& a_manager : managers) {
-        a_func(a_manager);
-    }
+void Manager::ClearSnapshot() {
+    std::lock_guard snapshot_lock(snapshot_mutex_);
+    auto& back = BackSnapshot();
+    back.BuildTable();
+    snapshot_.store(&back, std::memory_order_seq_cst);
+}
+
+const SubmittedPtr& Manager::GetSubmitted(const SkyPromptAPI::PromptSink* a_sink) const {
+    static const SubmittedPtr none;
+    const auto it = submitted_.find(a_sink);
+    return it != submitted_.end() ? it->second : none;
 }
 
 void Manager::AddEventToSend(const SkyPromptAPI::PromptSink* a_sink, const SkyPromptAPI::Prompt& a_prompt,
                              const SkyPromptAPI::PromptEventType event_type, const std::
-                             pair<float, float> a_delta) {
-    std::unique_lock lock(events_to_send_mutex);
-    if (const auto it = events_to_send_.find(a_sink); it != events_to_send_.end()) {
-        it->second.push_back({a_prompt, event_type, a_delta});
-    } else {
-        events_to_send_[a_sink] = {{a_prompt, event_type, a_delta}};
+                             pair<float, float> a_delta, SubmittedPtr a_source) {
+    std::lock_guard lock(events_mutex_);
+    if (tombstones_.contains(a_sink)) {
+        return;
     }
+    events_back_.push_back({a_sink, events_back_.size(), {a_prompt, event_type, a_delta}, std::move(a_source)});
 }
 
-void Manager::SendEvents() {
-    std::vector<const SkyPromptAPI::PromptSink*> sinks_to_notify;
+void Manager::SetBatchCallback(const SkyPromptAPI::PromptSink* a_sink, const PromptEventBatchCallback a_callback) {
+    std::lock_guard lock(events_mutex_);
+    if (a_callback) {
+        batch_callbacks_[a_sink] = a_callback;
+    } else {
+        batch_callbacks_.erase(a_sink);
+    }
+}
 
-    std::shared_lock lock(events_to_send_mutex);
+bool Manager::IsDropped(const SkyPromptAPI::PromptSink* a_sink) {
+    std::lock_guard lock(events_mutex_);
+    return !a_sink || tombstones_.contains(a_sink) || std::ranges::find(dropped_sinks_, a_sink) != dropped_sinks_.end();
+}
 
-    for (const auto& sink : events_to_send_ | std::views::keys) {
-        if (sink) {
-            sinks_to_notify.push_back(sink);
+void Manager::SendEvents() {
+    {
+        std::lock_guard lock(events_mutex_);
+        if (events_back_.empty()) {
+            return;
         }
+        std::swap(events_back_, events_front_);
+        dropped_sinks_.clear();
     }
 
-    for (const auto sink : sinks_to_notify) {
-        std::vector<SkyPromptAPI::PromptEvent> events;
-        if (auto it = events_to_send_.find(sink); it != events_to_send_.end()) {
-            events = it->second;
+    // group by sink, each sink's events in the order they were raised
+    std::ranges::sort(events_front_, [](const PendingEvent& a, const PendingEvent& b) {
+        if (a.sink != b.sink) {
+            return std::less<>{}(a.sink, b.sink);
         }
-        for (const auto& event : events) {
-            if (!sink || !events_to_send_.contains(sink)) {
-                break;
+        return a.seq < b.seq;
+    });
+
+    // events raised from inside a sink land in the back buffer and go out next frame
+    auto generation = drop_generation_.load(std::memory_order_acquire);
+    delivery_thread_.store(std::this_thread::get_id(), std::memory_order_release);
+    for (auto it = events_front_.begin(); it != events_front_.end();) {
+        const auto sink = it->sink;
+        const auto run_end = std::find_if(it, events_front_.end(), [sink](const PendingEvent& a_event) {
+            return a_event.sink != sink;
+        });
+
+        PromptEventBatchCallback batch = nullptr;
+        bool dropped;
+        {
+            std::lock_guard lock(events_mutex_);
+            dropped = !sink || tombstones_.contains(sink) ||
+                      std::ranges::find(dropped_sinks_, sink) != dropped_sinks_.end();
+            if (const auto cb = batch_callbacks_.find(sink); cb != batch_callbacks_.end()) {
+                batch = cb->second;
+            }
+            // set under the lock, so a Withdraw from another thread either stops this run or waits for it
+            if (!dropped) {
+                delivering_.store(sink, std::memory_order_release);
             }
-            lock.unlock();
-            sink->ProcessEvent(event);
-            lock.lock();
         }
-    }
 
-    lock.unlock();
+        if (!dropped && batch) {
+            batch_scratch_.clear();
+            for (auto e = it; e != run_end; ++e) {
+                batch_scratch_.push_back(e->event);
+            }
+            batch(sink, batch_scratch_.data(), batch_scratch_.size());
+        } else if (!dropped) {
+            for (auto e = it; e != run_end; ++e) {
+                // a sink can remove itself (and be freed) from its own ProcessEvent
+                if (const auto now = drop_generation_.load(std::memory_order_acquire); now != generation) {
+                    generation = now;
+                    if (IsDropped(sink)) {
+                        break;
+                    }
+                }
+                sink->ProcessEvent(e->event);
+            }
+        }
+        delivering_.store(nullptr, std::memory_order_release);
+        it = run_end;
+    }
 
-    std::unique_lock lock2(events_to_send_mutex);
-    events_to_send_.clear();
+    events_front_.clear();
 }
\ No newline at end of file
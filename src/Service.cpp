@@ -1,6 +1,7 @@
 #include "Service.h"
 #include "Renderer.h"
 #include "Theme.h"
+#include "Trace.h"
 
 bool ProcessSendPrompt(const SkyPromptAPI::PromptSink* a_sink, const SkyPromptAPI::ClientID a_clientID) {
     if (!a_sink) {
@@ -10,9 +11,11 @@ bool ProcessSendPrompt(const SkyPromptAPI::PromptSink* a_sink, const SkyPromptAP
         return false;
     }
 
-    const auto manager = MANAGER(ImGui::Renderer);
-    if (manager->IsInQueue(a_clientID, a_sink, true)) {
-        return false;
+    {
+        std::lock_guard lock(Service::mutex_);
+        if (a_clientID > Service::last_clientID) {
+            return false;
+        }
     }
 
     for (const auto new_prompts = a_sink->GetPrompts(); auto& prompt : new_prompts) {
@@ -21,7 +24,9 @@ bool ProcessSendPrompt(const SkyPromptAPI::PromptSink* a_sink, const SkyPromptAP
             return false;
         }
     }
-    return manager->Add2Q(a_sink, a_clientID);
+
+    // re-sends return false, same as before; the actual queue work happens on the render thread
+    return MANAGER(ImGui::Renderer)->Submit(a_sink, a_clientID);
 }
 
 void ProcessRemovePrompt(const SkyPromptAPI::PromptSink* a_sink, const SkyPromptAPI::ClientID a_clientID) {
@@ -33,12 +38,42 @@ void ProcessRemovePrompt(const SkyPromptAPI::PromptSink* a_sink, const SkyPrompt
         return;
     }
 
-    const auto manager = MANAGER(ImGui::Renderer);
-    if (!manager->IsInQueue(a_clientID, a_sink)) {
-        return;
+    MANAGER(Trace)->Remove(a_sink, a_clientID);
+    MANAGER(ImGui::Renderer)->Withdraw(a_sink, a_clientID);
+}
+
+bool ProcessSetEventBatchCallback(const SkyPromptAPI::PromptSink* a_sink, const SkyPromptAPI::ClientID a_clientID,
+                                  const PromptEventBatchCallback a_callback) {
+    if (!a_sink || a_clientID == 0) {
+        return false;
+    }
+
+    {
+        std::lock_guard lock(Service::mutex_);
+        if (a_clientID > Service::last_clientID) {
+            return false;
+        }
+    }
+
+    MANAGER(ImGui::Renderer)->SetBatchCallback(a_sink, a_callback);
+    return true;
+}
+
+bool ProcessSetPromptPriority(const SkyPromptAPI::PromptSink* a_sink, const SkyPromptAPI::ClientID a_clientID,
+                              const int a_priority) {
+    if (!a_sink || a_clientID == 0) {
+        return false;
+    }
+
+    {
+        std::lock_guard lock(Service::mutex_);
+        if (a_clientID > Service::last_clientID) {
+            return false;
+        }
     }
 
-    manager->RemoveFromQ(a_clientID, a_sink);
+    MANAGER(ImGui::Renderer)->SetPriority(a_sink, a_clientID, a_priority);
+    return true;
 }
 
 SkyPromptAPI::ClientID ProcessRequestClientID(int a_major, int a_minor) {
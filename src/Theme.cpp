@@ -42,6 +42,7 @@ Theme::Theme::Theme(const ThemeBlock& block) {
     }
 
     hide_in_menu = block.hide_in_menu.get();
+    coalesce_move = block.coalesce_move.get();
 }
 
 void Theme::Theme::ReLoad(std::string_view a_filename) {
@@ -0,0 +1,108 @@
+#include "Trace.h"
+
+bool Trace::Manager::Start(const std::filesystem::path& a_path) {
+    std::lock_guard lock(mutex_);
+    if (recording_.load()) {
+        return true;
+    }
+    file_.open(a_path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        logger::error("Failed to open trace file {}", a_path.string());
+        return false;
+    }
+    path_ = a_path;
+    started_ = std::chrono::steady_clock::now();
+    frame_ = 0;
+    Write(FileHeader{});
+    recording_.store(true);
+    logger::info("Recording trace to {}", a_path.string());
+    return true;
+}
+
+void Trace::Manager::Stop() {
+    std::lock_guard lock(mutex_);
+    if (!recording_.exchange(false)) {
+        return;
+    }
+    file_.close();
+    logger::info("Trace stopped after {} frames", frame_);
+}
+
+void Trace::Manager::Begin(const Kind a_kind) {
+    Write(RecordHeader{a_kind, frame_});
+}
+
+void Trace::Manager::Frame(const float a_seconds_since_last_frame) {
+    if (!IsRecording()) {
+        return;
+    }
+    std::lock_guard lock(mutex_);
+    if (!recording_.load()) {
+        return;
+    }
+    ++frame_;
+    Begin(Kind::kFrame);
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - started_).count();
+    Write(FrameRecord{a_seconds_since_last_frame, static_cast<uint64_t>(micros)});
+}
+
+void Trace::Manager::Input(const RE::InputEvent* a_event) {
+    if (!IsRecording() || !a_event) {
+        return;
+    }
+    std::lock_guard lock(mutex_);
+    if (!recording_.load()) {
+        return;
+    }
+    if (const auto button = a_event->AsButtonEvent()) {
+        Begin(Kind::kButton);
+        Write(ButtonRecord{button->GetIDCode(), static_cast<uint8_t>(button->GetDevice()), button->Value(),
+                           button->HeldDuration()});
+    } else if (const auto mouse = a_event->AsMouseMoveEvent()) {
+        Begin(Kind::kMouseMove);
+        Write(MouseMoveRecord{mouse->mouseInputX, mouse->mouseInputY});
+    } else if (const auto thumbstick = a_event->AsThumbstickEvent()) {
+        Begin(Kind::kThumbstick);
+        Write(ThumbstickRecord{static_cast<uint8_t>(thumbstick->IsLeft()), thumbstick->xValue, thumbstick->yValue});
+    }
+}
+
+void Trace::Manager::Send(const SkyPromptAPI::PromptSink* a_sink, const SkyPromptAPI::ClientID a_clientID,
+                          const std::span<const SkyPromptAPI::Prompt> a_prompts) {
+    if (!IsRecording() || !a_sink) {
+        return;
+    }
+    // the count is all a reader has to go by, so write no more prompts than it says
+    const auto count = static_cast<uint16_t>(std::min<size_t>(a_prompts.size(), std::numeric_limits<uint16_t>::max()));
+    std::lock_guard lock(mutex_);
+    if (!recording_.load()) {
+        return;
+    }
+    Begin(Kind::kSend);
+    Write(SendRecord{reinterpret_cast<uintptr_t>(a_sink), a_clientID, count});
+    for (const auto& [text, a_event, a_action, a_type, a_refid, button_key, text_color, progress] :
+         a_prompts.first(count)) {
+        const auto length = static_cast<uint16_t>(std::min<size_t>(text.size(), std::numeric_limits<uint16_t>::max()));
+        const auto key_count = static_cast<uint8_t>(std::min<size_t>(button_key.size(), 255));
+        Write(PromptRecord{static_cast<uint32_t>(a_event), static_cast<uint32_t>(a_action),
+                           static_cast<uint8_t>(a_type), static_cast<uint32_t>(a_refid), text_color, progress, length,
+                           key_count});
+        file_.write(text.data(), length);
+        for (size_t i = 0; i < key_count; ++i) {
+            Write(KeyRecord{static_cast<uint8_t>(button_key[i].first), static_cast<uint32_t>(button_key[i].second)});
+        }
+    }
+}
+
+void Trace::Manager::Remove(const SkyPromptAPI::PromptSink* a_sink, const SkyPromptAPI::ClientID a_clientID) {
+    if (!IsRecording() || !a_sink) {
+        return;
+    }
+    std::lock_guard lock(mutex_);
+    if (!recording_.load()) {
+        return;
+    }
+    Begin(Kind::kRemove);
+    Write(RemoveRecord{reinterpret_cast<uintptr_t>(a_sink), a_clientID});
+}
@@ -1,4 +1,3 @@
-#pragma once
 #include "Tutorial.h"
 #include "ClibUtil/simpleINI.hpp"
 
@@ -10,6 +9,7 @@ void Tutorial::Tutorial3::Sink::ProcessEvent(const SkyPromptAPI::PromptEvent eve
     switch (event.type) {
         case SkyPromptAPI::PromptEventType::kAccepted:
             SkyPromptAPI::RemovePrompt(this, client_id);
+            [[fallthrough]];
         case SkyPromptAPI::PromptEventType::kTimeout:
         case SkyPromptAPI::PromptEventType::kRemovedByMod:
         case SkyPromptAPI::PromptEventType::kTimingOut:
@@ -77,6 +77,7 @@ void Tutorial::Tutorial2::Sink::ProcessEvent(const SkyPromptAPI::PromptEvent eve
         case SkyPromptAPI::PromptEventType::kAccepted:
         case SkyPromptAPI::PromptEventType::kDeclined:
             SkyPromptAPI::RemovePrompt(this, client_id);
+            [[fallthrough]];
         case SkyPromptAPI::PromptEventType::kTimeout:
         case SkyPromptAPI::PromptEventType::kRemovedByMod:
         case SkyPromptAPI::PromptEventType::kTimingOut:
@@ -104,6 +105,7 @@ void Tutorial::Tutorial1::Sink::ProcessEvent(const SkyPromptAPI::PromptEvent eve
     switch (event.type) {
         case SkyPromptAPI::PromptEventType::kAccepted:
             SkyPromptAPI::RemovePrompt(this, client_id);
+            [[fallthrough]];
         case SkyPromptAPI::PromptEventType::kTimeout:
         case SkyPromptAPI::PromptEventType::kRemovedByMod:
         case SkyPromptAPI::PromptEventType::kTimingOut:
@@ -198,6 +200,7 @@ void Tutorial::Tutorial0::Sink::ProcessEvent(const SkyPromptAPI::PromptEvent eve
     switch (event.type) {
         case SkyPromptAPI::PromptEventType::kDeclined:
             SkyPromptAPI::RemovePrompt(this, client_id);
+            [[fallthrough]];
         case SkyPromptAPI::PromptEventType::kTimeout:
         case SkyPromptAPI::PromptEventType::kRemovedByMod:
         case SkyPromptAPI::PromptEventType::kTimingOut: